@@ -1,5 +1,10 @@
-from pymongo import MongoClient
-from pymongo.errors import PyMongoError
+from pymongo import MongoClient, ASCENDING
+from pymongo.errors import PyMongoError, BulkWriteError
+from itertools import islice
+import numpy as np
+import pandas as pd
+import mmap
+import struct
 import re
 import logging
 
@@ -7,6 +12,17 @@ import logging
 logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
 logger = logging.getLogger(__name__)
 
+# Columnar file format shared with Enhancement_Two/Enhanced_ABCU_Advising_Program.cpp.
+# A 64-byte header and one 64-byte directory entry per column are followed by 64-byte aligned
+# sections holding little-endian column values and string dictionaries.
+COLUMNAR_MAGIC = b'ABCUCOL1'
+COLUMNAR_ALIGNMENT = 64
+COLUMNAR_HEADER = struct.Struct('<8sIIQ')
+COLUMNAR_ENTRY = struct.Struct('<32sI4xQQQ')
+COLUMNAR_NUMERIC_TYPES = {1: '<i4', 2: '<u4', 3: '<f8', 5: '<i8', 6: '<u8', 7: '<M8[ns]'}
+COLUMNAR_DICTIONARY_STRING = 4
+COLUMNAR_TIMESTAMP = 7
+
 class CRUDOperations:
     """
     CRUD operations for MongoDB collections with connection pooling and enhanced security.
@@ -62,6 +78,28 @@ class CRUDOperations:
                     raise ValueError(f"Invalid characters in input: {value}")
         return True
 
+    def validate_operation(self, operation):
+        """
+        Validate the filter and document of a pymongo write operation with validate_input.
+
+        :param operation: InsertOne, UpdateOne, UpdateMany, ReplaceOne, DeleteOne or DeleteMany
+        :return: True if valid, raises ValueError if invalid
+        """
+        parts = [getattr(operation, '_filter', None), getattr(operation, '_doc', None)]
+        if not any(isinstance(part, (dict, list)) for part in parts):
+            raise ValueError(f"Unsupported write operation: {operation!r}")
+        for part in parts:
+            # Update pipelines are a list of stage documents
+            for data in (part if isinstance(part, list) else [part]):
+                if not isinstance(data, dict):
+                    continue
+                self.validate_input(data)
+                # Check the fields set by update operators such as {'$set': {...}} as well
+                for key, value in data.items():
+                    if key.startswith('$') and isinstance(value, dict):
+                        self.validate_input(value)
+        return True
+
     def create(self, data):
         """
         Inserts a document into the specified MongoDB collection.
@@ -80,18 +118,107 @@ class CRUDOperations:
             logger.error(f"Error inserting document: {e}")
             return False
 
-    def read(self, query):
+    def create_many(self, documents, batch_size=1000, ordered=False):
+        """
+        Inserts documents in batches with insert_many, one round trip per batch.
+
+        :param documents: Iterable of dictionaries; consumed lazily, one batch at a time.
+        :param batch_size: Number of documents sent per insert_many call.
+        :param ordered: Stop at the first failed document instead of inserting the rest of the batch.
+        :return: Number of documents inserted. Each batch is validated before it is sent; an invalid
+                 document stops the write, so earlier batches stay inserted and their count is returned.
+        """
+        if batch_size < 1:
+            raise ValueError("Batch size must be at least 1.")
+        inserted = 0
+        iterator = iter(documents)
+        while True:
+            batch = list(islice(iterator, batch_size))
+            if not batch:
+                break
+            try:
+                for data in batch:
+                    if not isinstance(data, dict):
+                        raise ValueError("Data must be a dictionary.")
+                    self.validate_input(data)
+            except ValueError as e:
+                logger.error(f"Invalid document, stopping after {inserted} inserted: {e}")
+                break
+            try:
+                result = self.collection.insert_many(batch, ordered=ordered)
+                inserted += len(result.inserted_ids)
+            except BulkWriteError as e:
+                inserted += e.details.get('nInserted', 0)
+                logger.error(f"Error inserting batch: {e.details.get('writeErrors', [])[:1]}")
+                if ordered:
+                    break
+            except PyMongoError as e:
+                logger.error(f"Error inserting batch: {e}")
+                break
+        logger.info(f"Inserted {inserted} documents")
+        return inserted
+
+    def bulk_write(self, operations, batch_size=1000, ordered=False):
+        """
+        Applies pymongo write operations (InsertOne, UpdateOne, DeleteMany, ...) in batches.
+
+        :param operations: Iterable of pymongo write operations; consumed lazily, one batch at a time.
+        :param batch_size: Number of operations sent per bulk_write call.
+        :param ordered: Stop at the first failed operation.
+        :return: Dictionary with inserted, matched, modified, deleted and upserted counts. Filters and
+                 documents are validated like create/update/delete, one batch at a time; an invalid
+                 operation stops the write and the totals of the batches already applied are returned.
+        """
+        if batch_size < 1:
+            raise ValueError("Batch size must be at least 1.")
+        totals = {'inserted': 0, 'matched': 0, 'modified': 0, 'deleted': 0, 'upserted': 0}
+        iterator = iter(operations)
+        while True:
+            batch = list(islice(iterator, batch_size))
+            if not batch:
+                break
+            try:
+                for operation in batch:
+                    self.validate_operation(operation)
+            except ValueError as e:
+                logger.error(f"Invalid operation, stopping after totals {totals}: {e}")
+                break
+            try:
+                result = self.collection.bulk_write(batch, ordered=ordered)
+                totals['inserted'] += result.inserted_count
+                totals['matched'] += result.matched_count
+                totals['modified'] += result.modified_count
+                totals['deleted'] += result.deleted_count
+                totals['upserted'] += result.upserted_count
+            except BulkWriteError as e:
+                details = e.details
+                totals['inserted'] += details.get('nInserted', 0)
+                totals['matched'] += details.get('nMatched', 0)
+                totals['modified'] += details.get('nModified', 0)
+                totals['deleted'] += details.get('nRemoved', 0)
+                totals['upserted'] += details.get('nUpserted', 0)
+                logger.error(f"Error in bulk write batch: {details.get('writeErrors', [])[:1]}")
+                if ordered:
+                    break
+            except PyMongoError as e:
+                logger.error(f"Error in bulk write batch: {e}")
+                break
+        logger.info(f"Bulk write totals: {totals}")
+        return totals
+
+    def read(self, query, projection=None):
         """
         Queries documents from the specified MongoDB collection.
 
         :param query: Dictionary representing the query criteria.
+        :param projection: Optional list of fields (or projection dictionary) to return.
         :return: List of documents matching the query, or an empty list if none match or an error occurs.
         """
         if not isinstance(query, dict):
             raise ValueError("Query must be a dictionary.")
         try:
             self.validate_input(query)
-            cursor = self.collection.find(query)
+            cursor = self.collection.find(query, projection)
             results = list(cursor)
             logger.info(f"Retrieved {len(results)} documents")
             return results
@@ -99,6 +226,68 @@ class CRUDOperations:
             logger.error(f"Error querying documents: {e}")
             return []
 
+    def stream(self, query, projection=None, batch_size=1000):
+        """
+        Yields documents matching the query without materializing the result set.
+
+        :param query: Dictionary representing the query criteria.
+        :param projection: Optional list of fields (or projection dictionary) to return.
+        :param batch_size: Number of documents the server returns per round trip.
+        :return: Generator of documents; stops early if an error occurs.
+        """
+        if not isinstance(query, dict):
+            raise ValueError("Query must be a dictionary.")
+        self.validate_input(query)
+
+        def documents():
+            count = 0
+            try:
+                for document in self.collection.find(query, projection, batch_size=batch_size):
+                    count += 1
+                    yield document
+            except PyMongoError as e:
+                logger.error(f"Error streaming documents: {e}")
+            logger.info(f"Streamed {count} documents")
+
+        return documents()
+
+    def read_page(self, query, projection=None, page_size=100, after=None, key='_id'):
+        """
+        Reads one page of documents using keyset pagination on an indexed, unique field.
+
+        Unlike skip/limit, each page is an index range scan that starts where the last one ended,
+        so late pages cost the same as early ones.
+
+        :param query: Dictionary representing the query criteria.
+        :param projection: Optional list of fields (or projection dictionary) to return; the key is always included.
+        :param page_size: Maximum number of documents in the page.
+        :param after: Key value of the last document of the previous page, or None for the first page.
+        :param key: Field to paginate on (default _id).
+        :return: Tuple (documents, next_after); next_after is None when there are no more pages.
+        """
+        if not isinstance(query, dict):
+            raise ValueError("Query must be a dictionary.")
+        if page_size < 1:
+            raise ValueError("Page size must be at least 1.")
+        self.validate_input(query)
+        if isinstance(projection, (list, tuple)):
+            projection = {field: 1 for field in list(projection) + [key]}
+        elif isinstance(projection, dict):
+            if projection.get(key, 1) == 0:
+                raise ValueError(f"Projection must include the pagination key '{key}'.")
+            # An inclusion projection returns only the fields it names, so name the key as well
+            if any(value not in (0, False) for field, value in projection.items() if field != '_id'):
+                projection = {**projection, key: 1}
+        page_query = query if after is None else {'$and': [query, {key: {'$gt': after}}]}
+        try:
+            cursor = self.collection.find(page_query, projection).sort(key, ASCENDING).limit(page_size)
+            documents = list(cursor)
+        except PyMongoError as e:
+            logger.error(f"Error reading page: {e}")
+            return [], None
+        next_after = documents[-1][key] if len(documents) == page_size else None
+        return documents, next_after
+
     def update(self, query, updates):
         """
         Update documents matching the query.
@@ -137,6 +326,139 @@ class CRUDOperations:
             logger.error(f"Failed to delete documents: {e}")
             return 0
 
+    @staticmethod
+    def read_columnar(path):
+        """
+        Load a columnar export file into a DataFrame without copying numeric column data.
+
+        The file is memory-mapped; numeric columns are NumPy views of the mapping and dictionary
+        string columns become Categoricals. Their codes are views too once a dictionary has 32768 or
+        more entries; below that pandas narrows the int32 codes to int8/int16, which copies at most
+        half the bytes. Only the dictionary entries themselves are decoded into Python strings.
+
+        :param path: Path of a file written by the C++ export or write_columnar
+        :return: DataFrame with one column per file column, in file order
+        """
+        with open(path, 'rb') as f:
+            mapped = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, version, column_count, row_count = COLUMNAR_HEADER.unpack_from(mapped, 0)
+        if magic != COLUMNAR_MAGIC or version != 1:
+            raise ValueError(f"Not a columnar export file: {path}")
+
+        columns = {}
+        for i in range(column_count):
+            name, column_type, data_offset, dictionary_offset, _ = COLUMNAR_ENTRY.unpack_from(
+                mapped, COLUMNAR_ALIGNMENT * (i + 1))
+            name = name.rstrip(b'\0').decode('utf-8')
+            if column_type in COLUMNAR_NUMERIC_TYPES:
+                columns[name] = np.frombuffer(mapped, dtype=COLUMNAR_NUMERIC_TYPES[column_type],
+                                              count=row_count, offset=data_offset)
+            elif column_type == COLUMNAR_DICTIONARY_STRING:
+                codes = np.frombuffer(mapped, dtype='<i4', count=row_count, offset=data_offset)
+                entry_count, = struct.unpack_from('<Q', mapped, dictionary_offset)
+                offsets = np.frombuffer(mapped, dtype='<u8', count=entry_count + 1,
+                                        offset=dictionary_offset + 8).tolist()
+                base = dictionary_offset + 8 * (entry_count + 2)
+                text = mapped[base:base + offsets[-1]].decode('utf-8')
+                if len(text) == offsets[-1]:
+                    # Pure ASCII: byte offsets are character offsets, so slice the decoded text
+                    entries = [text[start:end] for start, end in zip(offsets[:-1], offsets[1:])]
+                else:
+                    entries = [mapped[base + start:base + end].decode('utf-8')
+                               for start, end in zip(offsets[:-1], offsets[1:])]
+                columns[name] = pd.Categorical.from_codes(
+                    codes, dtype=pd.CategoricalDtype(entries), validate=False)
+            else:
+                raise ValueError(f"Unsupported column type {column_type} for column '{name}'")
+
+        logger.info(f"Read {row_count} rows and {column_count} columns from {path}")
+        return pd.DataFrame(columns, copy=False)
+
+    @staticmethod
+    def write_columnar(frame, path):
+        """
+        Write a DataFrame in the columnar export format.
+
+        Integer, unsigned, float and datetime columns keep their type. Timezone-aware datetimes are
+        stored in UTC and read back as naive UTC datetime64[ns]. Nullable integer columns (Int64, ...)
+        keep their integer type when they have no missing values and are stored as float64 with NaN
+        otherwise. Every other column, including bool and nullable boolean columns ('True'/'False'),
+        is stored as dictionary-encoded strings, with missing values preserved.
+
+        :param frame: DataFrame to write
+        :param path: Destination file path
+        """
+        def align(offset):
+            return (offset + COLUMNAR_ALIGNMENT - 1) // COLUMNAR_ALIGNMENT * COLUMNAR_ALIGNMENT
+
+        sections = []
+        for name, series in frame.items():
+            if isinstance(series.dtype, pd.DatetimeTZDtype):
+                series = series.dt.tz_convert('UTC').dt.tz_localize(None)
+            if not isinstance(series.dtype, np.dtype) and pd.api.types.is_integer_dtype(series.dtype):
+                series = series.astype('float64') if series.hasnans else series.astype(series.dtype.numpy_dtype)
+            plain = isinstance(series.dtype, np.dtype)
+            kind, size = (series.dtype.kind, series.dtype.itemsize) if plain else ('O', 0)
+            if kind in 'iu' and size <= 4:
+                column_type = 2 if kind == 'u' else 1
+                data, dictionary = series.to_numpy(dtype=COLUMNAR_NUMERIC_TYPES[column_type]).tobytes(), b''
+            elif kind in 'iu':
+                column_type = 6 if kind == 'u' else 5
+                data, dictionary = series.to_numpy(dtype=COLUMNAR_NUMERIC_TYPES[column_type]).tobytes(), b''
+            elif kind == 'M':
+                data, dictionary = series.to_numpy(dtype='datetime64[ns]').astype('<M8[ns]').tobytes(), b''
+                column_type = COLUMNAR_TIMESTAMP
+            elif kind == 'f':
+                data, dictionary = series.to_numpy(dtype='<f8').tobytes(), b''
+                column_type = 3
+            else:
+                # Factorize the string form so values like 1 and '1' share one dictionary entry
+                values = series.astype(object)
+                values = values.where(values.isna(), values.astype(str))
+                codes, uniques = pd.factorize(values, use_na_sentinel=True)
+                encoded = [str(value).encode('utf-8') for value in uniques]
+                offsets = np.concatenate(([0], np.cumsum([len(entry) for entry in encoded], dtype='<u8')))
+                data = codes.astype('<i4').tobytes()
+                dictionary = struct.pack('<Q', len(encoded)) + offsets.astype('<u8').tobytes() + b''.join(encoded)
+                column_type = COLUMNAR_DICTIONARY_STRING
+            sections.append((str(name).encode('utf-8')[:31], column_type, data, dictionary))
+
+        offset = COLUMNAR_ALIGNMENT * (1 + len(sections))
+        layout = []
+        for _, _, data, dictionary in sections:
+            data_offset = offset
+            offset = align(offset + len(data))
+            dictionary_offset = offset if dictionary else 0
+            offset = align(offset + len(dictionary))
+            layout.append((data_offset, dictionary_offset))
+
+        with open(path, 'wb') as f:
+            f.write(COLUMNAR_HEADER.pack(COLUMNAR_MAGIC, 1, len(sections), len(frame)).ljust(COLUMNAR_ALIGNMENT, b'\0'))
+            for (name, column_type, _, dictionary), (data_offset, dictionary_offset) in zip(sections, layout):
+                f.write(COLUMNAR_ENTRY.pack(name, column_type, data_offset, dictionary_offset, len(dictionary))
+                        .ljust(COLUMNAR_ALIGNMENT, b'\0'))
+            for _, _, data, dictionary in sections:
+                for section in (data, dictionary):
+                    f.write(section)
+                    f.write(b'\0' * (align(len(section)) - len(section)))
+        logger.info(f"Wrote {len(frame)} rows and {len(sections)} columns to {path}")
+
+    def export_columnar(self, query, path, columns=None):
+        """
+        Snapshot the documents matching a query into a local columnar file.
+
+        :param query: Dictionary representing the query criteria
+        :param path: Destination file path
+        :param columns: Optional list of fields to keep (all fields except _id by default)
+        :return: Number of documents written
+        """
+        frame = pd.DataFrame.from_records(self.stream(query, projection=columns))
+        frame = frame.drop(columns=['_id'], errors='ignore')
+        if columns is not None:
+            frame = frame.reindex(columns=columns)
+        self.write_columnar(frame, path)
+        return len(frame)
+
     def __del__(self):
         """
         Close MongoDB client connection when object is destroyed.
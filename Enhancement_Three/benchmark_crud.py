@@ -0,0 +1,138 @@
+"""
+Benchmark for CRUDOperations: per-document vs bulk writes, and materialized vs streaming reads.
+
+Runs against mongomock (an in-process stand-in for MongoDB) by default, so no database is needed:
+
+    python benchmark_crud.py --documents 20000
+
+Pass --mongod to run against a local mongod instead, using MONGO_USERNAME / MONGO_PASSWORD from the
+environment as the dashboard does. Throughput is documents per second; peak memory is the largest
+Python heap growth during the call, measured with tracemalloc.
+
+mongomock runs in-process, so it has no network round trips and scans the whole collection for
+every query. --round-trip-ms adds a sleep to each write call to model a remote server; keyset
+pagination is only representative against a real mongod, where each page is an index range scan.
+"""
+import argparse
+import logging
+import os
+import random
+import time
+import tracemalloc
+
+from pymongo import InsertOne
+
+import CRUDOperations
+
+DISPLAYED_FIELDS = ["animal_type", "breed", "outcome_type", "age_upon_outcome"]
+
+
+def make_documents(count, seed=42):
+    """Generate shelter-style documents, including fields the dashboard never displays."""
+    rng = random.Random(seed)
+    for i in range(count):
+        yield {
+            "animal_id": f"A{i:07d}",
+            "animal_type": rng.choice(["Dog", "Cat", "Bird"]),
+            "breed": rng.choice(["Labrador Retriever Mix", "German Shepherd", "Beagle", "Domestic Shorthair"]),
+            "color": rng.choice(["Black", "Brown", "White", "Tan"]),
+            "outcome_type": rng.choice(["Adoption", "Transfer", "Return to Owner"]),
+            "outcome_subtype": rng.choice(["Partner", "Foster", "SCRP", ""]),
+            "age_upon_outcome": f"{rng.randint(1, 15)} years",
+            "sex_upon_outcome": rng.choice(["Intact Male", "Intact Female", "Neutered Male", "Spayed Female"]),
+            "location_lat": 30.0 + rng.random(),
+            "location_long": -97.0 - rng.random(),
+            "intake_notes": "Lorem ipsum dolor sit amet " * 8,
+        }
+
+
+def measure(label, count, operation):
+    """Run an operation once and print its throughput and peak memory."""
+    tracemalloc.start()
+    tracemalloc.reset_peak()
+    baseline = tracemalloc.get_traced_memory()[0]
+    start = time.perf_counter()
+    processed = operation()
+    elapsed = time.perf_counter() - start
+    peak = tracemalloc.get_traced_memory()[1] - baseline
+    tracemalloc.stop()
+    if processed != count:
+        print(f"  warning: {label} processed {processed} of {count} documents")
+    print(f"  {label:<42} {count / elapsed:>12,.0f} docs/s {peak / 2**20:>10.1f} MiB peak")
+
+
+class RoundTripDelay:
+    """Collection proxy that sleeps once per write call to model latency to a remote server."""
+    WRITE_CALLS = ("insert_one", "insert_many", "bulk_write")
+
+    def __init__(self, collection, seconds):
+        self.collection = collection
+        self.seconds = seconds
+
+    def __getattr__(self, name):
+        attribute = getattr(self.collection, name)
+        if name not in self.WRITE_CALLS:
+            return attribute
+
+        def delayed(*args, **kwargs):
+            time.sleep(self.seconds)
+            return attribute(*args, **kwargs)
+        return delayed
+
+
+def connect(use_mongod, collection_name, round_trip_ms=0.0):
+    """Create a CRUDOperations instance against mongomock or a local mongod."""
+    if not use_mongod:
+        import mongomock
+        CRUDOperations.MongoClient = mongomock.MongoClient
+    crud = CRUDOperations.CRUDOperations(
+        os.getenv('MONGO_USERNAME', 'aacuser'), os.getenv('MONGO_PASSWORD', 'aacpassword123'),
+        os.getenv('MONGO_HOST', 'localhost'), int(os.getenv('MONGO_PORT', '27017')),
+        "crud_benchmark", collection_name
+    )
+    crud.collection.drop()
+    if round_trip_ms > 0:
+        crud.collection = RoundTripDelay(crud.collection, round_trip_ms / 1000.0)
+    return crud
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark CRUDOperations read and write paths.")
+    parser.add_argument("--documents", type=int, default=20000, help="number of documents per run")
+    parser.add_argument("--batch-size", type=int, default=1000, help="batch size for bulk and streaming calls")
+    parser.add_argument("--mongod", action="store_true", help="use a local mongod instead of mongomock")
+    parser.add_argument("--round-trip-ms", type=float, default=0.0, help="simulated latency per write call")
+    args = parser.parse_args()
+    logging.getLogger(CRUDOperations.__name__).setLevel(logging.WARNING)
+    n, batch, delay = args.documents, args.batch_size, args.round_trip_ms
+
+    print(f"Writes ({n} documents, batch size {batch}, {delay} ms per round trip):")
+    crud = connect(args.mongod, "create_one", delay)
+    measure("create (insert_one per document)", n,
+            lambda: sum(bool(crud.create(doc)) for doc in make_documents(n)))
+    crud = connect(args.mongod, "create_many", delay)
+    measure("create_many (insert_many batches)", n,
+            lambda: crud.create_many(make_documents(n), batch_size=batch))
+    crud = connect(args.mongod, "bulk_write", delay)
+    measure("bulk_write (InsertOne batches)", n,
+            lambda: crud.bulk_write((InsertOne(doc) for doc in make_documents(n)), batch_size=batch)['inserted'])
+
+    print(f"Reads ({n} documents, dashboard fields only where projected):")
+    crud.create_index([('animal_type', 1)])
+    measure("read (list of full documents)", n, lambda: len(crud.read({})))
+    measure("read with projection", n, lambda: len(crud.read({}, projection=DISPLAYED_FIELDS)))
+    measure("stream with projection", n,
+            lambda: sum(1 for _ in crud.stream({}, projection=DISPLAYED_FIELDS, batch_size=batch)))
+
+    def paginate():
+        total, after = 0, None
+        while True:
+            page, after = crud.read_page({}, projection=DISPLAYED_FIELDS, page_size=batch, after=after)
+            total += len(page)
+            if after is None:
+                return total
+    measure("read_page keyset pagination", n, paginate)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,166 @@
+"""
+Round-trip tests for the columnar export format. No database is needed: MongoDB is replaced by
+mongomock, and the C++ export test builds Enhancement_Two/Enhanced_ABCU_Advising_Program.cpp
+with g++ (skipped if g++ is not installed).
+
+    python -m unittest test_columnar
+"""
+import math
+import mmap
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+
+import mongomock
+import numpy as np
+import pandas as pd
+
+import CRUDOperations
+
+PROGRAM_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Enhancement_Two',
+                              'Enhanced_ABCU_Advising_Program.cpp')
+
+CATALOG_CSV = (
+    "CSCI100,Introduction to Computer Science\n"
+    "CSCI200,\"Data Structures, Part I\",CSCI100\n"
+    "CSCI300,Algorithms,CSCI200,MATH201\n"
+    "MATH201,Discrete Mathematics\n"
+    "CSCI400,Cycle A,CSCI401\n"
+    "CSCI401,Cycle B,CSCI400\n"
+)
+
+
+def is_file_view(array):
+    """Check whether an array's base chain ends at a memory-mapped file rather than a copy."""
+    while isinstance(array, np.ndarray):
+        array = array.base
+    return isinstance(array, memoryview) and isinstance(array.obj, mmap.mmap)
+
+
+def assert_view(test, array):
+    test.assertTrue(is_file_view(array))
+
+
+class TestColumnarRoundTrip(unittest.TestCase):
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def path(self, name):
+        return os.path.join(self.directory, name)
+
+    @unittest.skipIf(shutil.which('g++') is None, "g++ is required to build the C++ exporter")
+    def test_cpp_export(self):
+        program = self.path('abcu')
+        subprocess.run(['g++', '-std=c++17', '-O1', '-pthread', PROGRAM_SOURCE, '-o', program], check=True)
+        with open(self.path('catalog.csv'), 'w') as f:
+            f.write(CATALOG_CSV)
+        session = f"1\n{self.path('catalog.csv')}\n7\n{self.path('catalog.col')}\n9\n"
+        subprocess.run([program], input=session, text=True, check=True, capture_output=True)
+
+        frame = CRUDOperations.CRUDOperations.read_columnar(self.path('catalog.col'))
+        self.assertEqual(list(frame.columns), [
+            'course_number', 'program', 'title', 'prerequisites', 'prerequisite_count',
+            'direct_dependents', 'depth', 'downstream_chain', 'downstream_courses'])
+        self.assertEqual(str(frame['course_number'].dtype), 'category')
+        self.assertEqual(frame['prerequisite_count'].dtype, np.uint32)
+        self.assertEqual(frame['depth'].dtype, np.int32)
+        self.assertEqual(frame['downstream_courses'].dtype, np.float64)
+
+        rows = frame.set_index(frame['course_number'].astype(str))
+        self.assertEqual(list(rows.index), ['CSCI100', 'CSCI200', 'CSCI300', 'CSCI400', 'CSCI401', 'MATH201'])
+        self.assertEqual(rows.loc['CSCI200', 'title'], 'Data Structures, Part I')
+        self.assertEqual(rows.loc['CSCI300', 'prerequisites'], 'CSCI200;MATH201')
+        self.assertEqual(rows.loc['MATH201', 'program'], 'MATH')
+        self.assertEqual(rows.loc['CSCI300', 'depth'], 2)
+        self.assertEqual(rows.loc['CSCI100', 'downstream_courses'], 2.0)
+        self.assertEqual(rows.loc['CSCI100', 'downstream_chain'], 2)
+        self.assertEqual(rows.loc['CSCI100', 'direct_dependents'], 1)
+        # Courses in a prerequisite cycle are excluded from every metric
+        self.assertEqual(rows.loc['CSCI400', 'depth'], -1)
+        self.assertEqual(rows.loc['CSCI400', 'downstream_chain'], -1)
+        self.assertTrue(math.isnan(rows.loc['CSCI400', 'downstream_courses']))
+
+        assert_view(self, frame['depth'].to_numpy())
+        assert_view(self, frame['downstream_courses'].to_numpy())
+
+    def test_python_round_trip(self):
+        frame = pd.DataFrame({
+            'count': np.array([1, 2, 3], dtype='int32'),
+            'big': np.array([2**63, 0, 2**64 - 1], dtype='uint64'),
+            'signed': np.array([-2**63, 0, 2**63 - 1], dtype='int64'),
+            'ratio': [1.5, np.nan, -2.0],
+            'nullable': pd.array([1, None, 3], dtype='Int64'),
+            'complete': pd.array([4, 5, 6], dtype='Int64'),
+            'when': pd.to_datetime(['2024-01-01 00:00', None, '2025-06-30 12:00']),
+            'name': ['Grazioso', None, 'Café ünïcode ✓'],
+            'mixed': [1, '1', None],
+            'flag': [True, False, True],
+            'maybe': pd.array([True, None, False], dtype='boolean'),
+        })
+        CRUDOperations.CRUDOperations.write_columnar(frame, self.path('frame.col'))
+        result = CRUDOperations.CRUDOperations.read_columnar(self.path('frame.col'))
+
+        self.assertEqual(result['count'].dtype, np.int32)
+        self.assertEqual(result['big'].dtype, np.uint64)
+        self.assertEqual(result['big'].tolist(), [2**63, 0, 2**64 - 1])
+        self.assertEqual(result['signed'].tolist(), [-2**63, 0, 2**63 - 1])
+        self.assertTrue(np.isnan(result['ratio'][1]))
+        self.assertEqual(result['ratio'][2], -2.0)
+        self.assertEqual(result['nullable'].dtype, np.float64)
+        self.assertTrue(np.isnan(result['nullable'][1]))
+        self.assertEqual(result['complete'].dtype, np.int64)
+        self.assertEqual(result['when'].dtype, np.dtype('datetime64[ns]'))
+        self.assertTrue(pd.isna(result['when'][1]))
+        self.assertEqual(result['when'][2], pd.Timestamp('2025-06-30 12:00'))
+        self.assertEqual(result['name'][0], 'Grazioso')
+        self.assertTrue(pd.isna(result['name'][1]))
+        self.assertEqual(result['name'][2], 'Café ünïcode ✓')
+        # Values of different types with the same string form share one dictionary entry
+        self.assertEqual(list(result['mixed'].cat.categories), ['1'])
+        self.assertEqual(result['mixed'][:2].tolist(), ['1', '1'])
+        self.assertTrue(pd.isna(result['mixed'][2]))
+        self.assertEqual(result['flag'].tolist(), ['True', 'False', 'True'])
+        self.assertEqual(result['maybe'][2], 'False')
+        self.assertTrue(pd.isna(result['maybe'][1]))
+
+        for column in ['count', 'big', 'signed', 'ratio', 'when']:
+            assert_view(self, result[column].to_numpy())
+        self.assertFalse(is_file_view(frame['count'].to_numpy()))
+
+    def test_large_dictionary_codes_are_views(self):
+        # pandas narrows codes for dictionaries under 32768 entries, which copies them
+        frame = pd.DataFrame({'key': [f"K{i}" for i in range(40000)]})
+        CRUDOperations.CRUDOperations.write_columnar(frame, self.path('keys.col'))
+        result = CRUDOperations.CRUDOperations.read_columnar(self.path('keys.col'))
+        self.assertEqual(result['key'][39999], 'K39999')
+        assert_view(self, result['key'].array.codes)
+
+    def test_export_from_mongomock(self):
+        original_client = CRUDOperations.MongoClient
+        CRUDOperations.MongoClient = mongomock.MongoClient
+        try:
+            shelter = CRUDOperations.CRUDOperations('user', 'password', 'localhost', 27017, 'AAC', 'animals')
+        finally:
+            CRUDOperations.MongoClient = original_client
+        shelter.create_many([
+            {'animal_type': 'Dog', 'breed': 'Beagle', 'location_lat': 30.5, 'notes': 'unused'},
+            {'animal_type': 'Cat', 'breed': 'Siamese', 'location_lat': 30.25, 'notes': 'unused'},
+        ])
+        written = shelter.export_columnar({}, self.path('animals.col'),
+                                          columns=['animal_type', 'breed', 'location_lat'])
+        self.assertEqual(written, 2)
+
+        result = CRUDOperations.CRUDOperations.read_columnar(self.path('animals.col'))
+        self.assertEqual(list(result.columns), ['animal_type', 'breed', 'location_lat'])
+        self.assertEqual(result['breed'].astype(str).tolist(), ['Beagle', 'Siamese'])
+        self.assertEqual(result['location_lat'].tolist(), [30.5, 30.25])
+        assert_view(self, result['location_lat'].to_numpy())
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,88 @@
+"""
+Tests for the batched write paths of CRUDOperations, run against mongomock.
+
+    python -m unittest test_crud_operations
+"""
+import unittest
+
+import mongomock
+from pymongo import DeleteMany, InsertOne, UpdateOne
+
+import CRUDOperations
+
+
+def connect():
+    original_client = CRUDOperations.MongoClient
+    CRUDOperations.MongoClient = mongomock.MongoClient
+    try:
+        return CRUDOperations.CRUDOperations('user', 'password', 'localhost', 27017, 'AAC', 'animals')
+    finally:
+        CRUDOperations.MongoClient = original_client
+
+
+class TestBatchedWrites(unittest.TestCase):
+    def setUp(self):
+        self.shelter = connect()
+        self.shelter.collection.drop()
+
+    def test_create_many_returns_partial_count(self):
+        documents = [{'animal_id': f"A{i}"} for i in range(5)] + [{'animal_id': '$where'}]
+        inserted = self.shelter.create_many(documents, batch_size=2)
+        self.assertEqual(inserted, 4)
+        self.assertEqual(self.shelter.collection.count_documents({}), 4)
+
+    def test_bulk_write_validates_operations(self):
+        operations = [
+            InsertOne({'animal_id': 'A1'}),
+            InsertOne({'animal_id': 'A2'}),
+            DeleteMany({'animal_id': 'A1'}),
+            UpdateOne({'animal_id': 'A2'}, [{'$set': {'name': '<script>'}}]),
+            DeleteMany({}),
+        ]
+        totals = self.shelter.bulk_write(operations, batch_size=3)
+        self.assertEqual(totals['inserted'], 2)
+        self.assertEqual(totals['deleted'], 1)
+        self.assertEqual(self.shelter.collection.count_documents({}), 1)
+
+    def test_bulk_write_rejects_invalid_filter(self):
+        totals = self.shelter.bulk_write([DeleteMany({'animal_id': '$gt'})])
+        self.assertEqual(totals['deleted'], 0)
+
+
+
+class TestReadPage(unittest.TestCase):
+    def setUp(self):
+        self.shelter = connect()
+        self.shelter.collection.drop()
+        self.shelter.create_many({'code': f"C{i:02d}", 'title': f"Title {i}", 'notes': 'unused'} for i in range(5))
+
+    def read_all(self, projection, key='code'):
+        documents, after = [], None
+        while True:
+            page, after = self.shelter.read_page({}, projection=projection, page_size=2, after=after, key=key)
+            documents.extend(page)
+            if after is None:
+                return documents
+
+    def test_pages_cover_every_document_once(self):
+        documents = self.read_all(['title'])
+        self.assertEqual([doc['code'] for doc in documents], [f"C{i:02d}" for i in range(5)])
+        self.assertNotIn('notes', documents[0])
+
+    def test_inclusion_dictionary_gets_key(self):
+        documents = self.read_all({'title': 1})
+        self.assertEqual([doc['code'] for doc in documents], [f"C{i:02d}" for i in range(5)])
+        self.assertNotIn('notes', documents[0])
+
+    def test_exclusion_dictionary_keeps_key(self):
+        documents = self.read_all({'notes': 0})
+        self.assertEqual(len(documents), 5)
+        self.assertEqual(set(documents[0]), {'_id', 'code', 'title'})
+
+    def test_projection_excluding_key_is_rejected(self):
+        with self.assertRaises(ValueError):
+            self.shelter.read_page({}, projection={'code': 0}, key='code')
+
+
+if __name__ == '__main__':
+    unittest.main()
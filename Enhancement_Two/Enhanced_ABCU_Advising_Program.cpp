@@ -1,11 +1,23 @@
 #include <iostream>
 #include <fstream>
+#include <filesystem>
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
-#include <sstream>
 #include <string>
-#include <regex>
+#include <string_view>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <limits>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <iterator>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 // Course class to store course data
 class Course {
@@ -18,78 +30,455 @@ public:
         : courseNumber(num), courseTitle(title), prerequisites(prereqs) {}
 };
 
-// Function to split a string by delimiter
-std::vector<std::string> split(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delimiter)) {
-        if (!token.empty()) {
-            tokens.push_back(token);
+// Loaded courses are immutable and shared by the lookup map, the sorted list and the catalog history
+using CoursePtr = std::shared_ptr<const Course>;
+
+// Function to validate course number format (e.g., CSCI101): four uppercase letters then three digits
+bool isValidCourseNumber(std::string_view courseNumber) {
+    if (courseNumber.size() != 7) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        if (courseNumber[i] < 'A' || courseNumber[i] > 'Z') {
+            return false;
         }
     }
-    return tokens;
+    for (size_t i = 4; i < 7; ++i) {
+        if (courseNumber[i] < '0' || courseNumber[i] > '9') {
+            return false;
+        }
+    }
+    return true;
 }
 
-// Function to validate course number format (e.g., CSCI101)
-bool isValidCourseNumber(const std::string& courseNumber) {
-    std::regex pattern("^[A-Z]{4}[0-9]{3}$"); // e.g., CSCI101
-    return std::regex_match(courseNumber, pattern);
+// Bitmasks of the quote, comma and newline bytes in one 64-byte block (bit i = byte i)
+struct CsvBlockMasks {
+    std::uint64_t quotes;
+    std::uint64_t commas;
+    std::uint64_t newlines;
+};
+
+// Function to classify a 64-byte block, using AVX2 or SSE2 compares when available
+inline CsvBlockMasks classifyCsvBlock(const char* block) {
+    CsvBlockMasks masks{ 0, 0, 0 };
+#if defined(__AVX2__)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (int half = 0; half < 2; ++half) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * half));
+        const int shift = 32 * half;
+        masks.quotes |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote))) } << shift;
+        masks.commas |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, comma))) } << shift;
+        masks.newlines |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline))) } << shift;
+    }
+#elif defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (int quarter = 0; quarter < 4; ++quarter) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * quarter));
+        const int shift = 16 * quarter;
+        masks.quotes |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote))) } << shift;
+        masks.commas |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma))) } << shift;
+        masks.newlines |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline))) } << shift;
+    }
+#else
+    for (int i = 0; i < 64; ++i) {
+        const std::uint64_t bit = std::uint64_t{1} << i;
+        masks.quotes |= block[i] == '"' ? bit : 0;
+        masks.commas |= block[i] == ',' ? bit : 0;
+        masks.newlines |= block[i] == '\n' ? bit : 0;
+    }
+#endif
+    return masks;
 }
 
-// Function to read and parse CSV file into an unordered_map and sorted vector
-bool loadCoursesFromFile(const std::string& filename, std::unordered_map<std::string, Course>& courseMap, std::vector<Course>& sortedCourses) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "Error: Unable to open file '" << filename << "'." << std::endl;
-        return false;
+// Function to turn quote bits into an "inside quotes" mask: bit i is set when an odd number
+// of quotes precede or sit at byte i. Escaped quotes ("") toggle twice and cancel out.
+inline std::uint64_t prefixXor(std::uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Quote state carried from one 64-byte block to the next
+struct CsvScanState {
+    std::uint64_t insideQuotes = 0;       // all ones while a quoted field is open
+    std::uint64_t afterSeparator = 1;     // previous byte was a comma or newline (or start of file)
+    std::uint64_t afterClosingQuote = 0;  // previous byte closed a quoted field
+};
+
+// Function to classify a block one byte at a time. Used for blocks with quotes that do not
+// open a field (e.g. 12" Ruler); those are ordinary characters, as in an unquoted field.
+inline std::uint64_t classifyCsvBlockSlow(const char* block, CsvScanState& state) {
+    std::uint64_t structural = 0;
+    bool inQuotes = state.insideQuotes != 0;
+    bool afterSeparator = state.afterSeparator != 0;
+    bool afterClosingQuote = state.afterClosingQuote != 0;
+    for (int i = 0; i < 64; ++i) {
+        const char c = block[i];
+        const bool wasInQuotes = inQuotes;
+        bool closing = false;
+        if (inQuotes) {
+            closing = c == '"';
+            inQuotes = !closing;
+        } else if (c == '"' && (afterSeparator || afterClosingQuote)) {
+            inQuotes = true;
+        } else if (c == ',' || c == '\n') {
+            structural |= std::uint64_t{1} << i;
+        }
+        afterSeparator = !wasInQuotes && (c == ',' || c == '\n');
+        afterClosingQuote = closing;
     }
+    state.insideQuotes = inQuotes ? ~std::uint64_t{0} : 0;
+    state.afterSeparator = afterSeparator ? 1 : 0;
+    state.afterClosingQuote = afterClosingQuote ? 1 : 0;
+    return structural;
+}
 
-    courseMap.clear();
-    sortedCourses.clear();
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            continue;
+// Function to find the unquoted commas and newlines of a block. The prefix-XOR quote mask is
+// only valid if every quote that opens a quoted region sits at the start of a field or
+// directly after a closing quote (an escaped ""); otherwise the block is rescanned byte by byte.
+inline std::uint64_t structuralCsvBits(const char* block, const CsvBlockMasks& masks, CsvScanState& state) {
+    const std::uint64_t quoted = prefixXor(masks.quotes) ^ state.insideQuotes;
+    const std::uint64_t separators = masks.commas | masks.newlines;
+    const std::uint64_t closing = masks.quotes & ~quoted;
+    const std::uint64_t fieldStarts = (separators << 1) | state.afterSeparator;
+    const std::uint64_t afterClosing = (closing << 1) | state.afterClosingQuote;
+    const std::uint64_t strayQuotes = masks.quotes & quoted & ~(fieldStarts | afterClosing);
+    if (strayQuotes != 0) {
+        return classifyCsvBlockSlow(block, state);
+    }
+
+    state.insideQuotes = (quoted >> 63) ? ~std::uint64_t{0} : 0;
+    state.afterSeparator = separators >> 63;
+    state.afterClosingQuote = closing >> 63;
+    return separators & ~quoted;
+}
+
+// Totals reported by scanCsv
+struct CsvScanResult {
+    size_t records = 0;
+    size_t lines = 0;
+    bool unterminatedQuote = false;   // the last record is then dropped
+    size_t unterminatedLine = 0;
+    size_t unterminatedOffset = 0;
+};
+
+// The raw fields of one record, valid only for the duration of the onRecord call
+struct CsvFields {
+    const std::string_view* first;
+    size_t count;
+
+    size_t size() const { return count; }
+    const std::string_view& operator[](size_t i) const { return first[i]; }
+    const std::string_view* begin() const { return first; }
+    const std::string_view* end() const { return first + count; }
+};
+
+// Function to tokenize an RFC 4180 CSV buffer. Commas and newlines are classified a block
+// at a time; those inside quoted fields are masked out, so only field and record boundaries
+// are visited. A quote only opens a quoted field when it is the field's first byte. Each
+// record is passed to onRecord(fields, record, lineNumber, byteOffset) with the raw fields
+// (quoted fields keep their quotes; see csvFieldValue). CRLF endings are accepted.
+template <typename OnRecord>
+CsvScanResult scanCsv(std::string_view data, OnRecord&& onRecord) {
+    CsvScanResult result;
+    // Fields are written by index into storage that only grows, which keeps the per-field
+    // work to a store; push_back/clear on every record cost more than the block classifier
+    std::vector<std::string_view> fields(16);
+    size_t fieldCount = 0;
+    size_t recordStart = 0;
+    size_t fieldStart = 0;
+    size_t lineNumber = 1;
+    // Every newline ends a line, quoted or not, so line numbers come from the newline bits
+    size_t newlinesBefore = 0;
+
+    auto closeField = [&](size_t end) {
+        if (fieldCount == fields.size()) {
+            fields.resize(2 * fields.size());
         }
+        fields[fieldCount++] = std::string_view(data.data() + fieldStart, end - fieldStart);
+        fieldStart = end + 1;
+    };
+    auto closeRecord = [&](size_t end) {
+        std::string_view& last = fields[fieldCount - 1];
+        if (!last.empty() && last.back() == '\r') {
+            last.remove_suffix(1);
+        }
+        onRecord(CsvFields{ fields.data(), fieldCount },
+                 std::string_view(data.data() + recordStart, end - recordStart), lineNumber, recordStart);
+        ++result.records;
+        fieldCount = 0;
+        recordStart = end + 1;
+    };
 
-        std::vector<std::string> tokens = split(line, ',');
-        if (tokens.size() < 2) {
-            std::cout << "Warning: Invalid line in file: " << line << std::endl;
-            continue;
+    CsvScanState state;
+    char tail[64];
+    for (size_t blockStart = 0; blockStart < data.size(); blockStart += 64) {
+        const char* block = data.data() + blockStart;
+        if (data.size() - blockStart < 64) {
+            std::fill(std::begin(tail), std::end(tail), ' ');
+            std::copy(block, data.data() + data.size(), tail);
+            block = tail;
         }
 
-        std::string courseNumber = tokens[0];
-        if (!isValidCourseNumber(courseNumber)) {
-            std::cout << "Warning: Invalid course number format: " << courseNumber << std::endl;
-            continue;
+        const CsvBlockMasks masks = classifyCsvBlock(block);
+        std::uint64_t structural = structuralCsvBits(block, masks, state);
+        while (structural) {
+            const int bit = __builtin_ctzll(structural);
+            structural &= structural - 1;
+            const size_t position = blockStart + static_cast<size_t>(bit);
+            closeField(position);
+            if ((masks.newlines >> bit) & 1) {
+                closeRecord(position);
+                // Newlines up to and including this one (2 << 63 wraps to 0, selecting all 64 bits)
+                lineNumber = newlinesBefore + __builtin_popcountll(masks.newlines & ((std::uint64_t{2} << bit) - 1)) + 1;
+            }
         }
+        newlinesBefore += static_cast<size_t>(__builtin_popcountll(masks.newlines));
+    }
 
-        std::string courseTitle = tokens[1];
-        std::vector<std::string> prerequisites;
-        for (size_t i = 2; i < tokens.size(); ++i) {
-            if (!tokens[i].empty() && isValidCourseNumber(tokens[i])) {
-                prerequisites.push_back(tokens[i]);
+    // Final record without a trailing newline, unless an open quote swallowed it
+    if (state.insideQuotes) {
+        result.unterminatedQuote = true;
+        result.unterminatedLine = lineNumber;
+        result.unterminatedOffset = recordStart;
+    } else if (recordStart < data.size()) {
+        closeField(data.size());
+        closeRecord(data.size());
+    }
+    result.lines = newlinesBefore + (!data.empty() && data.back() != '\n' ? 1 : 0);
+    return result;
+}
+
+// Function to get a field's value, removing surrounding quotes and unescaping doubled quotes
+std::string csvFieldValue(std::string_view raw) {
+    if (raw.size() < 2 || raw.front() != '"' || raw.back() != '"') {
+        return std::string(raw);
+    }
+    std::string value;
+    value.reserve(raw.size() - 2);
+    for (size_t i = 1; i + 1 < raw.size(); ++i) {
+        value.push_back(raw[i]);
+        if (raw[i] == '"' && raw[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return value;
+}
+
+// Categories of problems that can be encountered while loading course data
+enum class LoadIssue : std::uint8_t {
+    InvalidLine,
+    InvalidCourseNumber,
+    InvalidPrerequisite,
+    UnterminatedQuote,
+    Count
+};
+
+// Compact record of a single load warning (16 bytes; no copy of the line text)
+struct LoadWarning {
+    std::uint64_t byteOffset;
+    std::uint32_t lineNumber;
+    LoadIssue issue;
+};
+
+// Collects warnings raised while loading a course file. Every warning is kept
+// in compact form and counted per category, but only the first few of each
+// category are echoed to the console so that a badly malformed file does not
+// spend its load time flushing the terminal.
+class LoadDiagnostics {
+public:
+    explicit LoadDiagnostics(size_t consoleLimitPerIssue = 5)
+        : consoleLimit(consoleLimitPerIssue) {
+        clear();
+    }
+
+    void clear() {
+        warnings.clear();
+        counts.fill(0);
+        linesRead = 0;
+        coursesLoaded = 0;
+    }
+
+    // Record a warning; the detail text is only formatted if it will be printed
+    void record(LoadIssue issue, size_t lineNumber, size_t byteOffset, std::string_view detail) {
+        warnings.push_back({ static_cast<std::uint64_t>(byteOffset), static_cast<std::uint32_t>(lineNumber), issue });
+        size_t count = ++counts[static_cast<size_t>(issue)];
+        if (count <= consoleLimit) {
+            std::cout << "Warning: " << describe(issue) << " at line " << lineNumber << ": '" << detail << "'\n";
+        } else if (count == consoleLimit + 1) {
+            std::cout << "Warning: further '" << describe(issue) << "' warnings suppressed\n";
+        }
+    }
+
+    void setTotals(size_t lines, size_t courses) {
+        linesRead = lines;
+        coursesLoaded = courses;
+    }
+
+    size_t warningCount() const { return warnings.size(); }
+
+    // Print a one-block summary of the last load
+    void printSummary() const {
+        std::cout << "Load summary: " << coursesLoaded << " courses loaded from " << linesRead
+                  << " lines, " << warnings.size() << " warnings";
+        if (!warnings.empty()) {
+            std::cout << " (";
+            for (size_t i = 0; i < counts.size(); ++i) {
+                std::cout << (i ? ", " : "") << counts[i] << " " << describe(static_cast<LoadIssue>(i));
             }
+            std::cout << ")";
         }
+        std::cout << std::endl;
+    }
 
-        Course course(courseNumber, courseTitle, prerequisites);
-        courseMap[courseNumber] = course;
-        sortedCourses.push_back(course);
+    // Write every recorded warning as a JSON report for external tooling
+    bool writeReport(const std::string& filename) const {
+        std::ofstream out(filename);
+        if (!out.is_open()) {
+            std::cout << "Error: Unable to open report file '" << filename << "'." << std::endl;
+            return false;
+        }
+
+        out << "{\n  \"lines_read\": " << linesRead << ",\n  \"courses_loaded\": " << coursesLoaded
+            << ",\n  \"counts\": {";
+        for (size_t i = 0; i < counts.size(); ++i) {
+            out << (i ? ", " : "") << "\"" << code(static_cast<LoadIssue>(i)) << "\": " << counts[i];
+        }
+        out << "},\n  \"warnings\": [";
+        for (size_t i = 0; i < warnings.size(); ++i) {
+            const LoadWarning& w = warnings[i];
+            out << (i ? ",\n    " : "\n    ") << "{\"line\": " << w.lineNumber << ", \"offset\": " << w.byteOffset
+                << ", \"code\": \"" << code(w.issue) << "\"}";
+        }
+        out << (warnings.empty() ? "]\n}\n" : "\n  ]\n}\n");
+        return static_cast<bool>(out);
+    }
+
+private:
+    static const char* describe(LoadIssue issue) {
+        switch (issue) {
+        case LoadIssue::InvalidLine: return "invalid line";
+        case LoadIssue::InvalidCourseNumber: return "invalid course number";
+        case LoadIssue::InvalidPrerequisite: return "invalid prerequisite";
+        case LoadIssue::UnterminatedQuote: return "unterminated quote";
+        default: return "unknown";
+        }
+    }
+
+    static const char* code(LoadIssue issue) {
+        switch (issue) {
+        case LoadIssue::InvalidLine: return "invalid_line";
+        case LoadIssue::InvalidCourseNumber: return "invalid_course_number";
+        case LoadIssue::InvalidPrerequisite: return "invalid_prerequisite";
+        case LoadIssue::UnterminatedQuote: return "unterminated_quote";
+        default: return "unknown";
+        }
+    }
+
+    size_t consoleLimit;
+    std::vector<LoadWarning> warnings;
+    std::array<size_t, static_cast<size_t>(LoadIssue::Count)> counts;
+    size_t linesRead;
+    size_t coursesLoaded;
+};
+
+// Function to read and parse CSV file into an unordered_map and sorted vector
+bool loadCoursesFromFile(const std::string& filename, std::unordered_map<std::string, CoursePtr>& courseMap,
+                         std::vector<CoursePtr>& sortedCourses, LoadDiagnostics& diagnostics) {
+    // Directories, FIFOs and devices cannot be read in one piece by size
+    std::error_code statusError;
+    std::ifstream file(filename, std::ios::binary);
+    if (!std::filesystem::is_regular_file(filename, statusError) || !file.is_open()) {
+        std::cout << "Error: Unable to open file '" << filename << "'." << std::endl;
+        return false;
+    }
+
+    // Read the whole file so the scanner can classify it a block at a time
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    std::string data;
+    if (size >= 0) {
+        data.resize(static_cast<size_t>(size));
+        file.seekg(0, std::ios::beg);
+        file.read(&data[0], static_cast<std::streamsize>(data.size()));
+    }
+    if (size < 0 || !file) {
+        std::cout << "Error: Unable to open file '" << filename << "'." << std::endl;
+        return false;
+    }
+    file.close();
+
+    // Courses identical to the previous load are reused, so a reload never holds two copies of them
+    std::unordered_map<std::string, CoursePtr> previous;
+    previous.swap(courseMap);
+    sortedCourses.clear();
+    diagnostics.clear();
+    const CsvScanResult scan = scanCsv(data,
+        [&](const CsvFields& fields, std::string_view record, size_t lineNumber, size_t byteOffset) {
+            if (fields.size() == 1 && fields[0].empty()) {
+                return;
+            }
+
+            if (fields.size() < 2 || fields[1].empty()) {
+                diagnostics.record(LoadIssue::InvalidLine, lineNumber, byteOffset, record);
+                return;
+            }
+
+            std::string courseNumber = csvFieldValue(fields[0]);
+            if (!isValidCourseNumber(courseNumber)) {
+                diagnostics.record(LoadIssue::InvalidCourseNumber, lineNumber, byteOffset, fields[0]);
+                return;
+            }
+
+            std::string courseTitle = csvFieldValue(fields[1]);
+            std::vector<std::string> prerequisites;
+            for (size_t i = 2; i < fields.size(); ++i) {
+                // Empty trailing columns are common in spreadsheet exports
+                if (fields[i].empty()) {
+                    continue;
+                }
+                std::string prereq = csvFieldValue(fields[i]);
+                if (isValidCourseNumber(prereq)) {
+                    prerequisites.push_back(std::move(prereq));
+                } else {
+                    diagnostics.record(LoadIssue::InvalidPrerequisite, lineNumber, byteOffset, fields[i]);
+                }
+            }
+
+            auto old = previous.find(courseNumber);
+            CoursePtr course = (old != previous.end() && old->second->courseTitle == courseTitle &&
+                                old->second->prerequisites == prerequisites)
+                ? old->second
+                : std::make_shared<const Course>(courseNumber, courseTitle, prerequisites);
+            courseMap.insert_or_assign(courseNumber, course);
+            sortedCourses.push_back(std::move(course));
+        });
+    if (scan.unterminatedQuote) {
+        diagnostics.record(LoadIssue::UnterminatedQuote, scan.unterminatedLine, scan.unterminatedOffset,
+                           std::string_view(data).substr(scan.unterminatedOffset, 40));
     }
 
     // Sort the vector once during loading
     std::sort(sortedCourses.begin(), sortedCourses.end(),
-        [](const Course& a, const Course& b) {
-            return a.courseNumber < b.courseNumber;
+        [](const CoursePtr& a, const CoursePtr& b) {
+            return a->courseNumber < b->courseNumber;
         });
 
-    file.close();
+    diagnostics.setTotals(scan.lines, sortedCourses.size());
+    diagnostics.printSummary();
     return true;
 }
 
 // Function to print all courses in alphanumeric order
-void printCourseList(const std::vector<Course>& sortedCourses) {
+void printCourseList(const std::vector<CoursePtr>& sortedCourses) {
     if (sortedCourses.empty()) {
         std::cout << "No courses loaded. Please load a file first." << std::endl;
         return;
@@ -97,12 +486,12 @@ void printCourseList(const std::vector<Course>& sortedCourses) {
 
     std::cout << "\nList of All Courses (Alphanumeric Order):\n" << std::endl;
     for (const auto& course : sortedCourses) {
-        std::cout << course.courseNumber << ": " << course.courseTitle << std::endl;
+        std::cout << course->courseNumber << ": " << course->courseTitle << std::endl;
     }
 }
 
 // Function to print course information and prerequisites
-void printCourseInfo(const std::unordered_map<std::string, Course>& courseMap, const std::string& courseNumber) {
+void printCourseInfo(const std::unordered_map<std::string, CoursePtr>& courseMap, const std::string& courseNumber) {
     if (courseMap.empty()) {
         std::cout << "No courses loaded. Please load a file first." << std::endl;
         return;
@@ -122,7 +511,7 @@ void printCourseInfo(const std::unordered_map<std::string, Course>& courseMap, c
         return;
     }
 
-    const Course& course = it->second;
+    const Course& course = *it->second;
     std::cout << "\nCourse Information:\n" << std::endl;
     std::cout << "Course Number: " << course.courseNumber << std::endl;
     std::cout << "Course Title: " << course.courseTitle << std::endl;
@@ -132,7 +521,7 @@ void printCourseInfo(const std::unordered_map<std::string, Course>& courseMap, c
     } else {
         for (size_t i = 0; i < course.prerequisites.size(); ++i) {
             auto prereqIt = courseMap.find(course.prerequisites[i]);
-            std::string prereqTitle = (prereqIt != courseMap.end()) ? prereqIt->second.courseTitle : "Unknown";
+            std::string prereqTitle = (prereqIt != courseMap.end()) ? prereqIt->second->courseTitle : "Unknown";
             std::cout << course.prerequisites[i] << " (" << prereqTitle << ")";
             if (i < course.prerequisites.size() - 1) {
                 std::cout << ", ";
@@ -142,27 +531,916 @@ void printCourseInfo(const std::unordered_map<std::string, Course>& courseMap, c
     }
 }
 
+// Prerequisite graph over the loaded catalog in compressed adjacency form.
+// Courses are indexed in alphanumeric order; prerequisites that are not in
+// the catalog are counted but not linked, and a prerequisite listed twice is
+// linked once.
+struct CatalogGraph {
+    std::vector<const Course*> courses;
+    std::vector<std::uint32_t> prereqOffsets;
+    std::vector<std::uint32_t> prereqs;        // edges course -> prerequisite
+    std::vector<std::uint32_t> dependentOffsets;
+    std::vector<std::uint32_t> dependents;     // edges prerequisite -> course
+    size_t unresolvedPrerequisites = 0;
+};
+
+// Function to build the prerequisite graph from the loaded catalog
+CatalogGraph buildCatalogGraph(const std::unordered_map<std::string, CoursePtr>& courseMap, const std::vector<CoursePtr>& sortedCourses) {
+    CatalogGraph graph;
+    graph.courses.reserve(courseMap.size());
+    for (const auto& course : sortedCourses) {
+        // Duplicate course numbers are adjacent after sorting; the map holds the one that was kept
+        if (graph.courses.empty() || graph.courses.back()->courseNumber != course->courseNumber) {
+            graph.courses.push_back(courseMap.at(course->courseNumber).get());
+        }
+    }
+
+    const size_t n = graph.courses.size();
+    std::unordered_map<std::string_view, std::uint32_t> indexOf;
+    indexOf.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        indexOf.emplace(graph.courses[i]->courseNumber, static_cast<std::uint32_t>(i));
+    }
+
+    graph.prereqOffsets.assign(n + 1, 0);
+    std::vector<std::uint32_t> dependentCounts(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (const auto& prereq : graph.courses[i]->prerequisites) {
+            auto it = indexOf.find(prereq);
+            if (it == indexOf.end()) {
+                ++graph.unresolvedPrerequisites;
+                continue;
+            }
+            if (std::find(graph.prereqs.begin() + graph.prereqOffsets[i], graph.prereqs.end(), it->second) != graph.prereqs.end()) {
+                continue;
+            }
+            graph.prereqs.push_back(it->second);
+            ++dependentCounts[it->second];
+        }
+        graph.prereqOffsets[i + 1] = static_cast<std::uint32_t>(graph.prereqs.size());
+    }
+
+    graph.dependentOffsets.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        graph.dependentOffsets[i + 1] = graph.dependentOffsets[i] + dependentCounts[i];
+    }
+    graph.dependents.resize(graph.prereqs.size());
+    std::vector<std::uint32_t> cursor(graph.dependentOffsets.begin(), graph.dependentOffsets.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (std::uint32_t e = graph.prereqOffsets[i]; e < graph.prereqOffsets[i + 1]; ++e) {
+            graph.dependents[cursor[graph.prereqs[e]]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return graph;
+}
+
+// Function to run fn(i) for every i in [begin, end), split across hardware threads when the range is large
+template <typename Fn>
+void parallelFor(size_t begin, size_t end, const Fn& fn) {
+    constexpr size_t kMinWorkPerThread = 4096;
+    const size_t count = end > begin ? end - begin : 0;
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threads = std::min(hardware, count / kMinWorkPerThread);
+    if (threads <= 1) {
+        for (size_t i = begin; i < end; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    const size_t chunk = (count + threads - 1) / threads;
+    for (size_t start = begin; start < end; start += chunk) {
+        const size_t stop = std::min(end, start + chunk);
+        workers.emplace_back([&fn, start, stop]() {
+            for (size_t i = start; i < stop; ++i) {
+                fn(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Per-course results of the catalog analytics
+struct CatalogAnalytics {
+    std::vector<std::uint32_t> order;         // courses grouped by prerequisite depth
+    std::vector<size_t> levelOffsets;         // order[levelOffsets[d] .. levelOffsets[d+1]) have depth d
+    std::vector<std::uint32_t> depth;         // longest prerequisite chain below a course (0 = none)
+    std::vector<std::uint32_t> chainParent;   // deepest prerequisite, or kNoCourse
+    std::vector<std::uint32_t> height;        // longest chain of courses that depend on a course
+    std::vector<std::uint32_t> directDependents; // courses listing this one as a prerequisite
+    std::vector<double> downstream;           // number of courses that transitively require a course
+    bool downstreamExact = true;
+    std::vector<std::uint32_t> refined;       // sketched courses whose downstream count was made exact
+    static constexpr std::uint32_t kNoCourse = 0xFFFFFFFFu;
+};
+
+// Catalogs up to this size get exact downstream counts from reachability bitsets;
+// larger ones use a k-mins reachability sketch (Cohen's size estimator), whose relative
+// standard error is about 1/sqrt(kSketchSize - 2), roughly 18%. The courses with the
+// largest estimates are the bottleneck candidates, so their counts are then recomputed
+// exactly by a breadth-first search (one search per candidate, each up to the catalog size).
+constexpr size_t kExactDownstreamLimit = 8192;
+constexpr size_t kSketchSize = 32;
+constexpr size_t kRefinedDownstream = 32;
+
+// Function to compute depth, chains and downstream reach with level-synchronous DAG dynamic programming
+CatalogAnalytics analyzeCatalog(const CatalogGraph& graph) {
+    const size_t n = graph.courses.size();
+    CatalogAnalytics result;
+    result.depth.assign(n, 0);
+    result.chainParent.assign(n, CatalogAnalytics::kNoCourse);
+    result.height.assign(n, 0);
+    result.directDependents.assign(n, 0);
+    result.downstream.assign(n, 0.0);
+    result.downstreamExact = n <= kExactDownstreamLimit;
+
+    // Kahn's algorithm one level at a time; a course's level is its prerequisite depth
+    std::vector<std::uint32_t> remaining(n);
+    result.order.reserve(n);
+    result.levelOffsets.push_back(0);
+    for (size_t i = 0; i < n; ++i) {
+        remaining[i] = graph.prereqOffsets[i + 1] - graph.prereqOffsets[i];
+        if (remaining[i] == 0) {
+            result.order.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    size_t levelBegin = 0;
+    while (levelBegin < result.order.size()) {
+        const size_t levelEnd = result.order.size();
+        result.levelOffsets.push_back(levelEnd);
+        const std::uint32_t nextDepth = static_cast<std::uint32_t>(result.levelOffsets.size() - 1);
+        for (size_t k = levelBegin; k < levelEnd; ++k) {
+            const std::uint32_t v = result.order[k];
+            for (std::uint32_t e = graph.dependentOffsets[v]; e < graph.dependentOffsets[v + 1]; ++e) {
+                const std::uint32_t d = graph.dependents[e];
+                if (--remaining[d] == 0) {
+                    result.depth[d] = nextDepth;
+                    result.order.push_back(d);
+                }
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    const size_t levels = result.levelOffsets.size() - 1;
+
+    // Forward pass: remember the deepest prerequisite so chains can be reconstructed
+    for (size_t level = 1; level < levels; ++level) {
+        parallelFor(result.levelOffsets[level], result.levelOffsets[level + 1], [&](size_t k) {
+            const std::uint32_t v = result.order[k];
+            for (std::uint32_t e = graph.prereqOffsets[v]; e < graph.prereqOffsets[v + 1]; ++e) {
+                const std::uint32_t p = graph.prereqs[e];
+                if (result.depth[p] + 1 == result.depth[v]) {
+                    result.chainParent[v] = p;
+                    break;
+                }
+            }
+        });
+    }
+
+    // Backward pass: dependents always sit on deeper levels, so each level only reads finished results.
+    // Dependents still waiting on prerequisites (remaining != 0) are in or behind a cycle and are skipped.
+    const size_t words = (n + 63) / 64;
+    std::vector<std::uint64_t> reach(result.downstreamExact ? n * words : 0);
+    std::vector<std::uint32_t> sketch(result.downstreamExact ? 0 : n * kSketchSize);
+    auto rank = [](std::uint64_t course, std::uint64_t j) {
+        std::uint64_t x = course * kSketchSize + j + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<std::uint32_t>((x ^ (x >> 31)) >> 32);
+    };
+
+    for (size_t level = levels; level-- > 0;) {
+        parallelFor(result.levelOffsets[level], result.levelOffsets[level + 1], [&](size_t k) {
+            const std::uint32_t v = result.order[k];
+            const std::uint32_t firstDependent = graph.dependentOffsets[v];
+            const std::uint32_t lastDependent = graph.dependentOffsets[v + 1];
+            std::uint32_t longest = 0;
+            std::uint32_t direct = 0;
+            for (std::uint32_t e = firstDependent; e < lastDependent; ++e) {
+                const std::uint32_t d = graph.dependents[e];
+                if (remaining[d] == 0) {
+                    longest = std::max(longest, result.height[d] + 1);
+                    ++direct;
+                }
+            }
+            result.height[v] = longest;
+            result.directDependents[v] = direct;
+
+            if (result.downstreamExact) {
+                std::uint64_t* mine = &reach[v * words];
+                for (std::uint32_t e = firstDependent; e < lastDependent; ++e) {
+                    const std::uint32_t d = graph.dependents[e];
+                    if (remaining[d] != 0) {
+                        continue;
+                    }
+                    const std::uint64_t* theirs = &reach[d * words];
+                    for (size_t w = 0; w < words; ++w) {
+                        mine[w] |= theirs[w];
+                    }
+                    mine[d / 64] |= std::uint64_t{1} << (d % 64);
+                }
+                size_t count = 0;
+                for (size_t w = 0; w < words; ++w) {
+                    count += static_cast<size_t>(__builtin_popcountll(mine[w]));
+                }
+                result.downstream[v] = static_cast<double>(count);
+            } else {
+                // Sketch includes the course itself; the estimate excludes it again
+                std::uint32_t* mine = &sketch[v * kSketchSize];
+                for (size_t j = 0; j < kSketchSize; ++j) {
+                    mine[j] = rank(v, j);
+                }
+                for (std::uint32_t e = firstDependent; e < lastDependent; ++e) {
+                    const std::uint32_t d = graph.dependents[e];
+                    if (remaining[d] != 0) {
+                        continue;
+                    }
+                    const std::uint32_t* theirs = &sketch[d * kSketchSize];
+                    for (size_t j = 0; j < kSketchSize; ++j) {
+                        mine[j] = std::min(mine[j], theirs[j]);
+                    }
+                }
+                if (direct > 0) {
+                    double sum = 0.0;
+                    for (size_t j = 0; j < kSketchSize; ++j) {
+                        sum += (static_cast<double>(mine[j]) + 1.0) / 4294967296.0;
+                    }
+                    result.downstream[v] = std::max(1.0, (kSketchSize - 1) / sum - 1.0);
+                }
+            }
+        });
+    }
+
+    if (!result.downstreamExact) {
+        std::vector<std::uint32_t> candidates(result.order);
+        const size_t refined = std::min(kRefinedDownstream, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(refined), candidates.end(),
+            [&](std::uint32_t a, std::uint32_t b) {
+                if (result.downstream[a] != result.downstream[b]) {
+                    return result.downstream[a] > result.downstream[b];
+                }
+                return a < b;
+            });
+        std::vector<std::uint32_t> seenBy(n, CatalogAnalytics::kNoCourse);
+        std::vector<std::uint32_t> queue;
+        for (std::uint32_t c = 0; c < refined; ++c) {
+            const std::uint32_t v = candidates[c];
+            queue.assign(1, v);
+            seenBy[v] = c;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                const std::uint32_t u = queue[head];
+                for (std::uint32_t e = graph.dependentOffsets[u]; e < graph.dependentOffsets[u + 1]; ++e) {
+                    const std::uint32_t d = graph.dependents[e];
+                    if (remaining[d] == 0 && seenBy[d] != c) {
+                        seenBy[d] = c;
+                        queue.push_back(d);
+                    }
+                }
+            }
+            result.downstream[v] = static_cast<double>(queue.size() - 1);
+        }
+        result.refined.assign(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(refined));
+    }
+    return result;
+}
+
+// Function to print a chain of courses, eliding the middle of very long chains
+void printChain(const CatalogGraph& graph, const CatalogAnalytics& analytics, std::uint32_t last) {
+    std::vector<std::uint32_t> chain;
+    for (std::uint32_t v = last; v != CatalogAnalytics::kNoCourse; v = analytics.chainParent[v]) {
+        chain.push_back(v);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    constexpr size_t kShown = 5;
+    for (size_t i = 0; i < chain.size(); ++i) {
+        if (chain.size() > 2 * kShown && i == kShown) {
+            std::cout << " -> ... (" << chain.size() - 2 * kShown << " more)";
+            i = chain.size() - kShown - 1;
+            continue;
+        }
+        std::cout << (i ? " -> " : "") << graph.courses[chain[i]]->courseNumber;
+    }
+    std::cout << std::endl;
+}
+
+// Function to print catalog-wide prerequisite analytics
+void printCatalogAnalytics(const std::unordered_map<std::string, CoursePtr>& courseMap, const std::vector<CoursePtr>& sortedCourses) {
+    if (sortedCourses.empty()) {
+        std::cout << "No courses loaded. Please load a file first." << std::endl;
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const CatalogGraph graph = buildCatalogGraph(courseMap, sortedCourses);
+    const CatalogAnalytics analytics = analyzeCatalog(graph);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    const size_t n = graph.courses.size();
+    const size_t acyclic = analytics.order.size();
+    const size_t levels = analytics.levelOffsets.size() - 1;
+    std::cout << "\nCatalog Analytics:\n" << std::endl;
+    std::cout << "Courses: " << n << ", prerequisite links: " << graph.prereqs.size()
+              << ", unresolved prerequisites: " << graph.unresolvedPrerequisites << std::endl;
+    if (acyclic < n) {
+        std::cout << "Warning: " << n - acyclic << " courses are in or depend on a prerequisite cycle and are excluded." << std::endl;
+    }
+    if (acyclic == 0) {
+        return;
+    }
+
+    // Depth statistics; order is already sorted by depth, so the median is read off directly
+    double depthSum = 0.0;
+    for (size_t level = 0; level < levels; ++level) {
+        depthSum += static_cast<double>(level) * (analytics.levelOffsets[level + 1] - analytics.levelOffsets[level]);
+    }
+    std::cout << "\nPrerequisite depth: max " << levels - 1 << ", mean " << depthSum / acyclic
+              << ", median " << analytics.depth[analytics.order[acyclic / 2]] << std::endl;
+    constexpr size_t kMaxHistogramRows = 20;
+    const size_t bucket = (levels + kMaxHistogramRows - 1) / kMaxHistogramRows;
+    for (size_t low = 0; low < levels; low += bucket) {
+        const size_t high = std::min(levels, low + bucket);
+        std::cout << "  depth " << low;
+        if (high - low > 1) {
+            std::cout << "-" << high - 1;
+        }
+        std::cout << ": " << analytics.levelOffsets[high] - analytics.levelOffsets[low] << " courses" << std::endl;
+    }
+
+    // Longest chain per program; courses of a program are contiguous in alphanumeric order
+    std::cout << "\nLongest prerequisite chain by program:" << std::endl;
+    for (size_t begin = 0; begin < n;) {
+        const std::string program = graph.courses[begin]->courseNumber.substr(0, 4);
+        size_t end = begin;
+        std::uint32_t deepest = CatalogAnalytics::kNoCourse;
+        while (end < n && graph.courses[end]->courseNumber.compare(0, 4, program) == 0) {
+            const bool inDag = analytics.depth[end] > 0 || graph.prereqOffsets[end] == graph.prereqOffsets[end + 1];
+            if (inDag && (deepest == CatalogAnalytics::kNoCourse || analytics.depth[end] > analytics.depth[deepest])) {
+                deepest = static_cast<std::uint32_t>(end);
+            }
+            ++end;
+        }
+        if (deepest != CatalogAnalytics::kNoCourse) {
+            std::cout << "  " << program << " (" << analytics.depth[deepest] + 1 << " courses): ";
+            printChain(graph, analytics, deepest);
+        }
+        begin = end;
+    }
+
+    // Bottlenecks: courses that gate the most downstream courses. With estimated counts the
+    // ranking is taken from the courses whose counts were made exact.
+    constexpr size_t kTopBottlenecks = 10;
+    std::vector<std::uint32_t> ranked(analytics.downstreamExact ? analytics.order : analytics.refined);
+    const size_t shown = std::min(kTopBottlenecks, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + shown, ranked.end(),
+        [&](std::uint32_t a, std::uint32_t b) {
+            if (analytics.downstream[a] != analytics.downstream[b]) {
+                return analytics.downstream[a] > analytics.downstream[b];
+            }
+            return a < b;
+        });
+    std::cout << "\nTop bottleneck courses";
+    if (!analytics.downstreamExact) {
+        std::cout << " (ranked among the " << analytics.refined.size() << " highest estimates, counted exactly)";
+    }
+    std::cout << ":" << std::endl;
+    for (size_t i = 0; i < shown && analytics.downstream[ranked[i]] > 0.0; ++i) {
+        const std::uint32_t v = ranked[i];
+        std::cout << "  " << graph.courses[v]->courseNumber << ": gates "
+                  << static_cast<size_t>(analytics.downstream[v] + 0.5) << " courses ("
+                  << analytics.directDependents[v] << " directly), longest downstream chain "
+                  << analytics.height[v] << std::endl;
+    }
+
+    std::cout << "\nAnalytics computed in " << elapsed.count() << " ms." << std::endl;
+}
+
+// Function to compare two courses field by field
+bool sameCourse(const Course& a, const Course& b) {
+    return a.courseNumber == b.courseNumber && a.courseTitle == b.courseTitle && a.prerequisites == b.prerequisites;
+}
+
+// Function to map a valid course number to a dense 29-bit key that preserves alphanumeric order
+std::uint32_t courseKey(std::string_view courseNumber) {
+    std::uint32_t key = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        key = key * 26 + static_cast<std::uint32_t>(courseNumber[i] - 'A');
+    }
+    for (size_t i = 4; i < 7; ++i) {
+        key = key * 10 + static_cast<std::uint32_t>(courseNumber[i] - '0');
+    }
+    return key;
+}
+
+// Node of the persistent course trie: 32-way branching on 5 key bits per level, with only
+// occupied slots stored. Nodes are shared between revisions and never modified once the
+// revision that created them has been committed.
+struct HistoryNode {
+    std::uint32_t bitmap = 0;
+    std::uint32_t generation = 0;
+    std::vector<std::shared_ptr<HistoryNode>> children;   // inner levels
+    std::vector<CoursePtr> courses;   // last level
+};
+
+// A course that differs between two catalog revisions
+struct CourseChange {
+    enum class Kind { Added, Removed, Modified };
+    Kind kind;
+    CoursePtr before;
+    CoursePtr after;
+};
+
+// Keeps every loaded catalog as an immutable revision. A new revision copies only the trie
+// paths leading to added, removed or changed courses; everything else, including the Course
+// objects themselves, is shared with the previous revision. Diffs skip shared subtrees, so
+// they cost time proportional to the number of changes rather than the catalog size.
+class CatalogHistory {
+public:
+    struct Revision {
+        std::shared_ptr<HistoryNode> root;
+        size_t courseCount;
+        std::string label;
+    };
+
+    // Record the loaded catalog as a new revision derived from the latest one; returns its number.
+    // Courses are stored by pointer, not copied. Loaded courses identical to the previous revision
+    // are replaced by that revision's objects in courseMap and sortedCourses, so unchanged courses
+    // exist once no matter how many revisions refer to them.
+    size_t commit(std::unordered_map<std::string, CoursePtr>& courseMap, std::vector<CoursePtr>& sortedCourses,
+                  const std::string& label) {
+        ++generation;
+        std::shared_ptr<HistoryNode> root = revisions.empty() ? nullptr : revisions.back().root;
+        const std::shared_ptr<HistoryNode> previous = root;
+
+        for (auto& entry : courseMap) {
+            const std::uint32_t key = courseKey(entry.first);
+            const CoursePtr* existing = find(previous.get(), key);
+            if (existing != nullptr && (*existing == entry.second || sameCourse(**existing, *entry.second))) {
+                entry.second = *existing;
+            } else {
+                assign(root, key, 0, entry.second);
+            }
+        }
+        for (auto& course : sortedCourses) {
+            const CoursePtr& kept = courseMap.at(course->courseNumber);
+            if (course != kept && sameCourse(*course, *kept)) {
+                course = kept;
+            }
+        }
+
+        forEachCourse(previous.get(), 0, [&](const CoursePtr& course) {
+            if (courseMap.find(course->courseNumber) == courseMap.end()) {
+                erase(root, courseKey(course->courseNumber), 0);
+            }
+        });
+
+        revisions.push_back({ root, courseMap.size(), label });
+        return revisions.size();
+    }
+
+    // Changes needed to turn revision 'from' into revision 'to' (1-based), in alphanumeric order
+    std::vector<CourseChange> diff(size_t from, size_t to) const {
+        std::vector<CourseChange> changes;
+        diffNodes(revisions.at(from - 1).root.get(), revisions.at(to - 1).root.get(), 0, changes);
+        return changes;
+    }
+
+    size_t size() const { return revisions.size(); }
+    const Revision& revision(size_t number) const { return revisions.at(number - 1); }
+
+private:
+    static constexpr int kLevels = 6;   // 6 x 5 bits covers the 29-bit course key
+    static constexpr int kBitsPerLevel = 5;
+
+    static std::uint32_t slotBit(std::uint32_t key, int level) {
+        return (key >> (kBitsPerLevel * (kLevels - 1 - level))) & 31u;
+    }
+
+    static size_t slotIndex(std::uint32_t bitmap, std::uint32_t bit) {
+        return static_cast<size_t>(__builtin_popcount(bitmap & ((1u << bit) - 1)));
+    }
+
+    static const CoursePtr* find(const HistoryNode* node, std::uint32_t key) {
+        for (int level = 0; node != nullptr; ++level) {
+            const std::uint32_t bit = slotBit(key, level);
+            if (!(node->bitmap & (1u << bit))) {
+                return nullptr;
+            }
+            const size_t index = slotIndex(node->bitmap, bit);
+            if (level == kLevels - 1) {
+                return &node->courses[index];
+            }
+            node = node->children[index].get();
+        }
+        return nullptr;
+    }
+
+    template <typename Fn>
+    static void forEachCourse(const HistoryNode* node, int level, const Fn& fn) {
+        if (node == nullptr) {
+            return;
+        }
+        if (level == kLevels - 1) {
+            for (const auto& course : node->courses) {
+                fn(course);
+            }
+            return;
+        }
+        for (const auto& child : node->children) {
+            forEachCourse(child.get(), level + 1, fn);
+        }
+    }
+
+    // Nodes created during the current commit are still private and can be edited in place;
+    // anything older is copied first (path copying)
+    void makeWritable(std::shared_ptr<HistoryNode>& node) const {
+        if (!node) {
+            node = std::make_shared<HistoryNode>();
+            node->generation = generation;
+        } else if (node->generation != generation) {
+            node = std::make_shared<HistoryNode>(*node);
+            node->generation = generation;
+        }
+    }
+
+    void assign(std::shared_ptr<HistoryNode>& node, std::uint32_t key, int level, CoursePtr course) {
+        makeWritable(node);
+        const std::uint32_t bit = slotBit(key, level);
+        const std::uint32_t mask = 1u << bit;
+        const size_t index = slotIndex(node->bitmap, bit);
+        if (level == kLevels - 1) {
+            if (node->bitmap & mask) {
+                node->courses[index] = std::move(course);
+            } else {
+                node->bitmap |= mask;
+                node->courses.insert(node->courses.begin() + static_cast<std::ptrdiff_t>(index), std::move(course));
+            }
+            return;
+        }
+        if (!(node->bitmap & mask)) {
+            node->bitmap |= mask;
+            node->children.insert(node->children.begin() + static_cast<std::ptrdiff_t>(index), nullptr);
+        }
+        assign(node->children[index], key, level + 1, std::move(course));
+    }
+
+    // Remove a course; empty nodes are pruned on the way back up
+    void erase(std::shared_ptr<HistoryNode>& node, std::uint32_t key, int level) {
+        const std::uint32_t bit = slotBit(key, level);
+        const std::uint32_t mask = 1u << bit;
+        if (!node || !(node->bitmap & mask)) {
+            return;
+        }
+        makeWritable(node);
+        const size_t index = slotIndex(node->bitmap, bit);
+        if (level == kLevels - 1) {
+            node->courses.erase(node->courses.begin() + static_cast<std::ptrdiff_t>(index));
+            node->bitmap &= ~mask;
+        } else {
+            erase(node->children[index], key, level + 1);
+            if (!node->children[index]) {
+                node->children.erase(node->children.begin() + static_cast<std::ptrdiff_t>(index));
+                node->bitmap &= ~mask;
+            }
+        }
+        if (node->bitmap == 0) {
+            node.reset();
+        }
+    }
+
+    static void diffNodes(const HistoryNode* before, const HistoryNode* after, int level, std::vector<CourseChange>& changes) {
+        if (before == after) {
+            return;
+        }
+        const std::uint32_t beforeBits = before ? before->bitmap : 0;
+        const std::uint32_t afterBits = after ? after->bitmap : 0;
+        for (std::uint32_t pending = beforeBits | afterBits; pending != 0; pending &= pending - 1) {
+            const std::uint32_t bit = static_cast<std::uint32_t>(__builtin_ctz(pending));
+            const bool inBefore = (beforeBits >> bit) & 1u;
+            const bool inAfter = (afterBits >> bit) & 1u;
+            const size_t beforeIndex = slotIndex(beforeBits, bit);
+            const size_t afterIndex = slotIndex(afterBits, bit);
+
+            if (level < kLevels - 1) {
+                diffNodes(inBefore ? before->children[beforeIndex].get() : nullptr,
+                          inAfter ? after->children[afterIndex].get() : nullptr, level + 1, changes);
+            } else if (inBefore && inAfter) {
+                const auto& oldCourse = before->courses[beforeIndex];
+                const auto& newCourse = after->courses[afterIndex];
+                if (oldCourse != newCourse && !sameCourse(*oldCourse, *newCourse)) {
+                    changes.push_back({ CourseChange::Kind::Modified, oldCourse, newCourse });
+                }
+            } else if (inBefore) {
+                changes.push_back({ CourseChange::Kind::Removed, before->courses[beforeIndex], nullptr });
+            } else {
+                changes.push_back({ CourseChange::Kind::Added, nullptr, after->courses[afterIndex] });
+            }
+        }
+    }
+
+    std::vector<Revision> revisions;
+    std::uint32_t generation = 0;
+};
+
+// Function to format a prerequisite list as [A, B]
+std::string formatPrerequisites(const std::vector<std::string>& prerequisites) {
+    std::string text = "[";
+    for (size_t i = 0; i < prerequisites.size(); ++i) {
+        text += (i ? ", " : "") + prerequisites[i];
+    }
+    return text + "]";
+}
+
+// Function to print the differences between two catalog revisions
+void printCatalogDiff(const CatalogHistory& history, size_t from, size_t to) {
+    const std::vector<CourseChange> changes = history.diff(from, to);
+    size_t added = 0, removed = 0, retitled = 0, prerequisitesChanged = 0;
+    for (const auto& change : changes) {
+        if (change.kind == CourseChange::Kind::Added) {
+            ++added;
+        } else if (change.kind == CourseChange::Kind::Removed) {
+            ++removed;
+        } else {
+            retitled += change.before->courseTitle != change.after->courseTitle;
+            prerequisitesChanged += change.before->prerequisites != change.after->prerequisites;
+        }
+    }
+    std::cout << "Revision " << from << " -> " << to << ": " << added << " added, " << removed << " removed, "
+              << retitled << " retitled, " << prerequisitesChanged << " prerequisite changes" << std::endl;
+
+    constexpr size_t kMaxChangesShown = 50;
+    for (size_t i = 0; i < changes.size() && i < kMaxChangesShown; ++i) {
+        const CourseChange& change = changes[i];
+        if (change.kind == CourseChange::Kind::Added) {
+            std::cout << "  + " << change.after->courseNumber << ": " << change.after->courseTitle << std::endl;
+        } else if (change.kind == CourseChange::Kind::Removed) {
+            std::cout << "  - " << change.before->courseNumber << ": " << change.before->courseTitle << std::endl;
+        } else {
+            std::cout << "  ~ " << change.after->courseNumber << ":";
+            if (change.before->courseTitle != change.after->courseTitle) {
+                std::cout << " title '" << change.before->courseTitle << "' -> '" << change.after->courseTitle << "'";
+            }
+            if (change.before->prerequisites != change.after->prerequisites) {
+                std::cout << " prerequisites " << formatPrerequisites(change.before->prerequisites)
+                          << " -> " << formatPrerequisites(change.after->prerequisites);
+            }
+            std::cout << std::endl;
+        }
+    }
+    if (changes.size() > kMaxChangesShown) {
+        std::cout << "  ... " << changes.size() - kMaxChangesShown << " more changes" << std::endl;
+    }
+}
+
+// Function to prompt for a revision number; returns 0 if the input is not a recorded revision
+size_t readRevisionNumber(const CatalogHistory& history, const std::string& prompt) {
+    std::cout << prompt;
+    std::string input;
+    std::getline(std::cin, input);
+    const auto isDigit = [](unsigned char c) { return std::isdigit(c) != 0; };
+    if (input.empty() || input.size() > 9 || !std::all_of(input.begin(), input.end(), isDigit)) {
+        return 0;
+    }
+    const size_t number = static_cast<size_t>(std::stoul(input));
+    return number <= history.size() ? number : 0;
+}
+
+// Function to list the recorded revisions and compare two of them
+void compareCatalogRevisions(const CatalogHistory& history) {
+    if (history.size() == 0) {
+        std::cout << "No courses loaded. Please load a file first." << std::endl;
+        return;
+    }
+
+    std::cout << "\nCatalog Revisions:\n" << std::endl;
+    for (size_t number = 1; number <= history.size(); ++number) {
+        const CatalogHistory::Revision& revision = history.revision(number);
+        std::cout << number << ". " << revision.label << " (" << revision.courseCount << " courses)" << std::endl;
+    }
+
+    const size_t from = readRevisionNumber(history, "Enter the older revision number: ");
+    const size_t to = from ? readRevisionNumber(history, "Enter the newer revision number: ") : 0;
+    if (from == 0 || to == 0) {
+        std::cout << "Error: Invalid revision number." << std::endl;
+        return;
+    }
+    printCatalogDiff(history, from, to);
+}
+
+// Columnar export file format (little-endian, every section 64-byte aligned so readers can
+// memory-map it and view columns in place):
+//   header     64 bytes: magic "ABCUCOL1", uint32 version, uint32 column count, uint64 row count
+//   directory  64 bytes per column: name (32 bytes, NUL padded), uint32 type, uint32 reserved,
+//              uint64 data offset, uint64 dictionary offset, uint64 dictionary length
+//   data       row count values of the column type; dictionary columns store int32 codes and
+//              timestamps are int64 nanoseconds since the Unix epoch (UTC)
+//   dictionary uint64 entry count, uint64 offsets[count + 1], then the UTF-8 bytes of all entries
+// Enhancement_Three/CRUDOperations.py reads and writes the same format.
+enum class ColumnType : std::uint32_t {
+    Int32 = 1,
+    UInt32 = 2,
+    Float64 = 3,
+    DictionaryString = 4,
+    Int64 = 5,
+    UInt64 = 6,      // written by CRUDOperations.py only
+    Timestamp = 7    // written by CRUDOperations.py only
+};
+
+// Builds columns in memory and writes them in the columnar export format
+class ColumnarWriter {
+public:
+    explicit ColumnarWriter(size_t rowCount) : rows(rowCount) {}
+
+    void addInt32(const std::string& name, const std::vector<std::int32_t>& values) {
+        addColumn(name, ColumnType::Int32, values.data(), values.size() * sizeof(std::int32_t));
+    }
+
+    void addUInt32(const std::string& name, const std::vector<std::uint32_t>& values) {
+        addColumn(name, ColumnType::UInt32, values.data(), values.size() * sizeof(std::uint32_t));
+    }
+
+    void addFloat64(const std::string& name, const std::vector<double>& values) {
+        addColumn(name, ColumnType::Float64, values.data(), values.size() * sizeof(double));
+    }
+
+    // Dictionary-encode a string column; entries are numbered in order of first appearance
+    void addStrings(const std::string& name, const std::vector<std::string_view>& values) {
+        std::unordered_map<std::string_view, std::int32_t> codeOf;
+        std::vector<std::int32_t> codes;
+        std::vector<std::uint64_t> offsets{ 0 };
+        std::string bytes;
+        codes.reserve(values.size());
+        for (std::string_view value : values) {
+            auto inserted = codeOf.emplace(value, static_cast<std::int32_t>(offsets.size() - 1));
+            if (inserted.second) {
+                bytes.append(value.data(), value.size());
+                offsets.push_back(bytes.size());
+            }
+            codes.push_back(inserted.first->second);
+        }
+
+        addColumn(name, ColumnType::DictionaryString, codes.data(), codes.size() * sizeof(std::int32_t));
+        Column& column = columns.back();
+        const std::uint64_t entryCount = offsets.size() - 1;
+        column.dictionary.resize(sizeof(std::uint64_t) * (offsets.size() + 1) + bytes.size());
+        char* out = &column.dictionary[0];
+        std::memcpy(out, &entryCount, sizeof(entryCount));
+        std::memcpy(out + sizeof(entryCount), offsets.data(), offsets.size() * sizeof(std::uint64_t));
+        std::memcpy(out + sizeof(std::uint64_t) * (offsets.size() + 1), bytes.data(), bytes.size());
+    }
+
+    bool write(const std::string& filename) const {
+        std::ofstream out(filename, std::ios::binary);
+        if (!out.is_open()) {
+            std::cout << "Error: Unable to open export file '" << filename << "'." << std::endl;
+            return false;
+        }
+
+        // Lay out every section before writing so the directory can hold final offsets
+        std::uint64_t offset = kAlignment * (1 + columns.size());
+        std::vector<std::uint64_t> dataOffsets, dictionaryOffsets;
+        for (const Column& column : columns) {
+            dataOffsets.push_back(offset);
+            offset = alignUp(offset + column.data.size());
+            dictionaryOffsets.push_back(column.dictionary.empty() ? 0 : offset);
+            offset = alignUp(offset + column.dictionary.size());
+        }
+
+        char header[kAlignment] = {};
+        const std::uint32_t version = 1;
+        const std::uint32_t columnCount = static_cast<std::uint32_t>(columns.size());
+        const std::uint64_t rowCount = rows;
+        std::memcpy(header, "ABCUCOL1", 8);
+        std::memcpy(header + 8, &version, 4);
+        std::memcpy(header + 12, &columnCount, 4);
+        std::memcpy(header + 16, &rowCount, 8);
+        out.write(header, kAlignment);
+
+        for (size_t i = 0; i < columns.size(); ++i) {
+            char entry[kAlignment] = {};
+            const std::uint64_t dictionaryLength = columns[i].dictionary.size();
+            std::memcpy(entry, columns[i].name.data(), std::min<size_t>(columns[i].name.size(), 31));
+            std::memcpy(entry + 32, &columns[i].type, 4);
+            std::memcpy(entry + 40, &dataOffsets[i], 8);
+            std::memcpy(entry + 48, &dictionaryOffsets[i], 8);
+            std::memcpy(entry + 56, &dictionaryLength, 8);
+            out.write(entry, kAlignment);
+        }
+
+        for (const Column& column : columns) {
+            writePadded(out, column.data);
+            writePadded(out, column.dictionary);
+        }
+        return static_cast<bool>(out);
+    }
+
+private:
+    static constexpr std::uint64_t kAlignment = 64;
+
+    struct Column {
+        std::string name;
+        ColumnType type;
+        std::string data;
+        std::string dictionary;
+    };
+
+    static std::uint64_t alignUp(std::uint64_t offset) {
+        return (offset + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    static void writePadded(std::ofstream& out, const std::string& section) {
+        static const char padding[kAlignment] = {};
+        out.write(section.data(), static_cast<std::streamsize>(section.size()));
+        out.write(padding, static_cast<std::streamsize>(alignUp(section.size()) - section.size()));
+    }
+
+    void addColumn(const std::string& name, ColumnType type, const void* data, size_t length) {
+        columns.push_back({ name, type, std::string(static_cast<const char*>(data), length), std::string() });
+    }
+
+    size_t rows;
+    std::vector<Column> columns;
+};
+
+// Function to export the catalog and its prerequisite graph metrics as a columnar file
+bool exportCatalogColumns(const std::string& filename, const std::unordered_map<std::string, CoursePtr>& courseMap,
+                          const std::vector<CoursePtr>& sortedCourses) {
+    const CatalogGraph graph = buildCatalogGraph(courseMap, sortedCourses);
+    const CatalogAnalytics analytics = analyzeCatalog(graph);
+    const size_t n = graph.courses.size();
+
+    // Courses left out of the analysis by a prerequisite cycle get depth and height -1 and NaN downstream courses
+    std::vector<bool> analyzed(n, false);
+    for (std::uint32_t v : analytics.order) {
+        analyzed[v] = true;
+    }
+
+    std::vector<std::string> prerequisiteLists(n);
+    std::vector<std::string_view> numbers(n), programs(n), titles(n), prerequisites(n);
+    std::vector<std::uint32_t> prerequisiteCounts(n), dependentCounts(n);
+    std::vector<std::int32_t> depths(n), heights(n);
+    std::vector<double> downstream(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Course& course = *graph.courses[i];
+        for (size_t p = 0; p < course.prerequisites.size(); ++p) {
+            prerequisiteLists[i] += (p ? ";" : "") + course.prerequisites[p];
+        }
+        numbers[i] = course.courseNumber;
+        programs[i] = std::string_view(course.courseNumber).substr(0, 4);
+        titles[i] = course.courseTitle;
+        prerequisites[i] = prerequisiteLists[i];
+        prerequisiteCounts[i] = static_cast<std::uint32_t>(course.prerequisites.size());
+        dependentCounts[i] = analytics.directDependents[i];
+        depths[i] = analyzed[i] ? static_cast<std::int32_t>(analytics.depth[i]) : -1;
+        heights[i] = analyzed[i] ? static_cast<std::int32_t>(analytics.height[i]) : -1;
+        downstream[i] = analyzed[i] ? analytics.downstream[i] : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    ColumnarWriter writer(n);
+    writer.addStrings("course_number", numbers);
+    writer.addStrings("program", programs);
+    writer.addStrings("title", titles);
+    writer.addStrings("prerequisites", prerequisites);
+    writer.addUInt32("prerequisite_count", prerequisiteCounts);
+    writer.addUInt32("direct_dependents", dependentCounts);
+    writer.addInt32("depth", depths);
+    writer.addInt32("downstream_chain", heights);
+    writer.addFloat64("downstream_courses", downstream);
+    return writer.write(filename);
+}
+
 // Function to display the menu
 void displayMenu() {
     std::cout << "\nABCU Advising Assistance Program\n" << std::endl;
     std::cout << "1. Load Course Data" << std::endl;
     std::cout << "2. Print Alphanumeric Course List" << std::endl;
     std::cout << "3. Print Course Information" << std::endl;
+    std::cout << "4. Write Load Diagnostics Report" << std::endl;
+    std::cout << "5. Print Catalog Analytics" << std::endl;
+    std::cout << "6. Compare Catalog Revisions" << std::endl;
+    std::cout << "7. Export Catalog Columns" << std::endl;
     std::cout << "9. Exit" << std::endl;
-    std::cout << "\nEnter your choice (1, 2, 3, or 9): ";
+    std::cout << "\nEnter your choice (1, 2, 3, 4, 5, 6, 7, or 9): ";
 }
 
+#ifndef ABCU_NO_MAIN
 int main() {
-    std::unordered_map<std::string, Course> courseMap;
-    std::vector<Course> sortedCourses;
+    std::unordered_map<std::string, CoursePtr> courseMap;
+    std::vector<CoursePtr> sortedCourses;
+    LoadDiagnostics diagnostics;
+    CatalogHistory history;
     std::string input;
 
     while (true) {
         displayMenu();
         std::getline(std::cin, input);
 
-        if (input != "1" && input != "2" && input != "3" && input != "9") {
-            std::cout << "Error: Invalid choice. Please enter 1, 2, 3, or 9." << std::endl;
+        if (input != "1" && input != "2" && input != "3" && input != "4" && input != "5" && input != "6" && input != "7" && input != "9") {
+            std::cout << "Error: Invalid choice. Please enter 1, 2, 3, 4, 5, 6, 7, or 9." << std::endl;
             continue;
         }
 
@@ -171,8 +1449,13 @@ int main() {
         if (choice == 1) {
             std::cout << "Enter the course data file name (e.g., CS 300 ABCU_Advising_Program_Input.csv): ";
             std::getline(std::cin, input);
-            if (loadCoursesFromFile(input, courseMap, sortedCourses)) {
+            if (loadCoursesFromFile(input, courseMap, sortedCourses, diagnostics)) {
                 std::cout << "File '" << input << "' loaded successfully." << std::endl;
+                const size_t revision = history.commit(courseMap, sortedCourses, input);
+                std::cout << "Recorded as catalog revision " << revision << "." << std::endl;
+                if (revision > 1) {
+                    printCatalogDiff(history, revision - 1, revision);
+                }
             }
         } else if (choice == 2) {
             printCourseList(sortedCourses);
@@ -184,6 +1467,30 @@ int main() {
             } else {
                 std::cout << "Error: Course number cannot be empty." << std::endl;
             }
+        } else if (choice == 4) {
+            std::cout << "Enter the report file name (e.g., load_report.json): ";
+            std::getline(std::cin, input);
+            if (input.empty()) {
+                std::cout << "Error: Report file name cannot be empty." << std::endl;
+            } else if (diagnostics.writeReport(input)) {
+                std::cout << "Wrote " << diagnostics.warningCount() << " warnings to '" << input << "'." << std::endl;
+            }
+        } else if (choice == 5) {
+            printCatalogAnalytics(courseMap, sortedCourses);
+        } else if (choice == 6) {
+            compareCatalogRevisions(history);
+        } else if (choice == 7) {
+            if (sortedCourses.empty()) {
+                std::cout << "No courses loaded. Please load a file first." << std::endl;
+                continue;
+            }
+            std::cout << "Enter the export file name (e.g., catalog.abcucol): ";
+            std::getline(std::cin, input);
+            if (input.empty()) {
+                std::cout << "Error: Export file name cannot be empty." << std::endl;
+            } else if (exportCatalogColumns(input, courseMap, sortedCourses)) {
+                std::cout << "Exported " << courseMap.size() << " courses to '" << input << "'." << std::endl;
+            }
         } else if (choice == 9) {
             std::cout << "Exiting program. Goodbye!" << std::endl;
             break;
@@ -191,4 +1498,5 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
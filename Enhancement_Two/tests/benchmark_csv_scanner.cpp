@@ -0,0 +1,92 @@
+// Throughput benchmark for scanCsv. Generates a synthetic catalog in memory (or reads a CSV
+// file given on the command line) and reports GB/s for the block classifier on its own and
+// for the full tokenizer with a callback that only counts fields:
+//   g++ -std=c++17 -O2 -pthread benchmark_csv_scanner.cpp -o benchmark_csv_scanner
+//   ./benchmark_csv_scanner [courses | file.csv]
+// Add -mavx2 for the AVX2 path, or -U__SSE2__ -U__AVX2__ for the scalar one.
+#define ABCU_NO_MAIN
+#include "../Enhanced_ABCU_Advising_Program.cpp"
+
+#include <random>
+#include <sstream>
+
+// Function to build a catalog of the given size: short course lines with 0-3 prerequisites,
+// and every tenth title quoted with an embedded comma
+std::string makeCatalog(size_t courses) {
+    std::mt19937 random(42);
+    std::string data;
+    data.reserve(courses * 48);
+    auto number = [](size_t i) {
+        std::string code = "AAAA000";
+        for (int d = 6; d >= 4; --d, i /= 10) {
+            code[d] = static_cast<char>('0' + i % 10);
+        }
+        for (int l = 3; l >= 0; --l, i /= 26) {
+            code[l] = static_cast<char>('A' + i % 26);
+        }
+        return code;
+    };
+    for (size_t i = 0; i < courses; ++i) {
+        data += number(i);
+        data += i % 10 == 0 ? ",\"Title, part " + std::to_string(i) + "\"" : ",Title " + std::to_string(i);
+        for (size_t p = random() % 4; p > 0 && i > 0; --p) {
+            data += ',';
+            data += number(random() % i);
+        }
+        data += '\n';
+    }
+    return data;
+}
+
+// Function to time an operation over several runs and print the best throughput
+template <typename Operation>
+void measure(const char* label, size_t bytes, Operation&& operation) {
+    double best = 0.0;
+    size_t checksum = 0;
+    for (int run = 0; run < 5; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        checksum = operation();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, static_cast<double>(bytes) / elapsed.count() / 1e9);
+    }
+    std::cout << "  " << label << ": " << best << " GB/s (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string data;
+    const std::string argument = argc > 1 ? argv[1] : "1000000";
+    if (!argument.empty() && std::all_of(argument.begin(), argument.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        data = makeCatalog(std::stoul(argument));
+    } else {
+        std::ifstream file(argument, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        data = contents.str();
+    }
+#if defined(__AVX2__)
+    const char* path = "AVX2";
+#elif defined(__SSE2__)
+    const char* path = "SSE2";
+#else
+    const char* path = "scalar";
+#endif
+    std::cout << "scanCsv benchmark (" << path << "), " << data.size() / 1e6 << " MB" << std::endl;
+
+    measure("block classifier", data.size(), [&] {
+        CsvScanState state;
+        size_t structural = 0;
+        for (size_t blockStart = 0; blockStart + 64 <= data.size(); blockStart += 64) {
+            const char* block = data.data() + blockStart;
+            structural += static_cast<size_t>(__builtin_popcountll(structuralCsvBits(block, classifyCsvBlock(block), state)));
+        }
+        return structural;
+    });
+    measure("scanCsv, counting fields", data.size(), [&] {
+        size_t fields = 0;
+        scanCsv(data, [&](const CsvFields& recordFields, std::string_view, size_t, size_t) {
+            fields += recordFields.size();
+        });
+        return fields;
+    });
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/bin/sh
+# Build and run the scanner tests once per CSV classification path (SSE2, AVX2, scalar),
+# then the remaining tests with the default flags.
+set -e
+cd "$(dirname "$0")"
+out="${TMPDIR:-/tmp}"
+status=0
+for flags in "" "-mavx2" "-U__SSE2__ -U__AVX2__"; do
+    g++ -std=c++17 -O2 -pthread $flags test_csv_scanner.cpp -o "$out/test_csv_scanner" || { status=1; continue; }
+    "$out/test_csv_scanner" || status=1
+done
+for test in test_load_diagnostics test_catalog_history test_catalog_analytics; do
+    g++ -std=c++17 -O2 -pthread $test.cpp -o "$out/$test" || { status=1; continue; }
+    "$out/$test" || status=1
+done
+exit $status
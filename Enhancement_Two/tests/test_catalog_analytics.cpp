@@ -0,0 +1,172 @@
+// Tests for buildCatalogGraph and analyzeCatalog: exact results on a small catalog with a
+// cycle, a repeated prerequisite and an unresolved one, and the accuracy of the downstream
+// sketch used above kExactDownstreamLimit courses.
+//   g++ -std=c++17 -pthread test_catalog_analytics.cpp
+#define ABCU_NO_MAIN
+#include "../Enhanced_ABCU_Advising_Program.cpp"
+
+#include <random>
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        ++failures;
+        std::cout << "FAIL: " << what << std::endl;
+    }
+}
+
+struct Catalog {
+    std::unordered_map<std::string, CoursePtr> courseMap;
+    std::vector<CoursePtr> sortedCourses;
+};
+
+// Function to build a sorted catalog, as loadCoursesFromFile leaves it
+Catalog makeCatalog(const std::vector<Course>& courses) {
+    Catalog catalog;
+    for (const auto& course : courses) {
+        CoursePtr pointer = std::make_shared<const Course>(course);
+        catalog.courseMap.insert_or_assign(course.courseNumber, pointer);
+        catalog.sortedCourses.push_back(pointer);
+    }
+    std::sort(catalog.sortedCourses.begin(), catalog.sortedCourses.end(),
+        [](const CoursePtr& a, const CoursePtr& b) { return a->courseNumber < b->courseNumber; });
+    return catalog;
+}
+
+void testSmallCatalog() {
+    // CSCI200 lists CSCI100 twice, CSCI250 lists a course that does not exist, CYCL100 and
+    // CYCL200 require each other, and CYCL300 requires the cycle and MATH100
+    const Catalog catalog = makeCatalog({
+        { "CSCI100", "Intro", {} },
+        { "CSCI200", "Data", { "CSCI100", "CSCI100" } },
+        { "CSCI250", "Systems", { "CSCI100", "BOGU999" } },
+        { "CSCI300", "Algorithms", { "CSCI200", "CSCI250" } },
+        { "CSCI400", "Capstone", { "CSCI300" } },
+        { "CYCL100", "Cycle A", { "CYCL200" } },
+        { "CYCL200", "Cycle B", { "CYCL100" } },
+        { "CYCL300", "Behind the cycle", { "CYCL100", "MATH100" } },
+        { "MATH100", "Algebra", {} },
+        { "MATH200", "Calculus", { "MATH100" } },
+    });
+    const CatalogGraph graph = buildCatalogGraph(catalog.courseMap, catalog.sortedCourses);
+    check(graph.courses.size() == 10, "course count");
+    check(graph.unresolvedPrerequisites == 1, "unresolved prerequisite counted");
+    check(graph.prereqs.size() == 10, "repeated prerequisite linked once");
+
+    const CatalogAnalytics analytics = analyzeCatalog(graph);
+    constexpr std::uint32_t none = CatalogAnalytics::kNoCourse;
+    // Index:                          CSCI100  200  250  300  400  CYCL100  200   300  MATH100  200
+    const std::vector<std::uint32_t> depth{       0,   1,   1,   2,   3,       0,    0,    0,       0,   1 };
+    const std::vector<std::uint32_t> chainParent{ none, 0,  0,   1,   3,    none, none, none,    none,   8 };
+    const std::vector<std::uint32_t> height{      3,   2,   2,   1,   0,       0,    0,    0,       1,   0 };
+    const std::vector<std::uint32_t> direct{      2,   1,   1,   1,   0,       0,    0,    0,       1,   0 };
+    const std::vector<double> downstream{         4,   2,   2,   1,   0,       0,    0,    0,       1,   0 };
+    check(analytics.depth == depth, "depth");
+    check(analytics.chainParent == chainParent, "chainParent");
+    check(analytics.height == height, "height");
+    check(analytics.directDependents == direct, "directDependents");
+    check(analytics.downstream == downstream, "downstream");
+    check(analytics.downstreamExact, "small catalog is exact");
+
+    std::vector<std::uint32_t> order(analytics.order);
+    std::sort(order.begin(), order.end());
+    check(order == std::vector<std::uint32_t>{ 0, 1, 2, 3, 4, 8, 9 }, "cycle and its dependent excluded");
+    check(analytics.levelOffsets == std::vector<size_t>{ 0, 2, 5, 6, 7 }, "level offsets");
+}
+
+// Function to name course i so that alphanumeric order matches i
+std::string courseNumber(size_t i) {
+    std::string code = "AAAA000";
+    for (int d = 6; d >= 4; --d, i /= 10) {
+        code[d] = static_cast<char>('0' + i % 10);
+    }
+    for (int l = 3; l >= 0; --l, i /= 26) {
+        code[l] = static_cast<char>('A' + i % 26);
+    }
+    return code;
+}
+
+void testSketchAccuracy() {
+    // Each course requires 1-3 of the 300 courses before it, so reach varies from a handful
+    // of courses to most of the catalog
+    constexpr size_t n = 20000;
+    std::mt19937 random(7);
+    std::vector<Course> courses;
+    std::vector<std::vector<std::uint32_t>> prereqs(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<std::string> names;
+        for (size_t p = i == 0 ? 0 : 1 + random() % 3; p > 0; --p) {
+            const size_t window = std::min<size_t>(i, 300);
+            const std::uint32_t prereq = static_cast<std::uint32_t>(i - 1 - random() % window);
+            if (std::find(prereqs[i].begin(), prereqs[i].end(), prereq) == prereqs[i].end()) {
+                prereqs[i].push_back(prereq);
+                names.push_back(courseNumber(prereq));
+            }
+        }
+        courses.push_back({ courseNumber(i), "Course", names });
+    }
+    const Catalog catalog = makeCatalog(courses);
+    const CatalogGraph graph = buildCatalogGraph(catalog.courseMap, catalog.sortedCourses);
+    const CatalogAnalytics analytics = analyzeCatalog(graph);
+    check(!analytics.downstreamExact, "large catalog uses the sketch");
+
+    // Exact reference: prerequisites always come earlier, so fill reach sets from the end
+    constexpr size_t words = (n + 63) / 64;
+    std::vector<std::uint64_t> reach(n * words, 0);
+    std::vector<size_t> exact(n, 0);
+    for (size_t i = n; i-- > 0;) {
+        for (size_t w = 0; w < words; ++w) {
+            exact[i] += static_cast<size_t>(__builtin_popcountll(reach[i * words + w]));
+        }
+        for (std::uint32_t p : prereqs[i]) {
+            for (size_t w = 0; w < words; ++w) {
+                reach[p * words + w] |= reach[i * words + w];
+            }
+            reach[p * words + i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+
+    // Stated tolerance for the estimates (relative standard error about 18% with 32 minima):
+    // median error within 15%, 90% of courses within 35%, and no course off by more than 100%
+    std::vector<double> errors;
+    for (size_t i = 0; i < n; ++i) {
+        if (exact[i] == 0) {
+            check(analytics.downstream[i] == 0.0, "no dependents means no downstream courses");
+        } else if (exact[i] >= 32) {
+            errors.push_back(std::abs(analytics.downstream[i] - static_cast<double>(exact[i])) / static_cast<double>(exact[i]));
+        }
+    }
+    std::sort(errors.begin(), errors.end());
+    const double median = errors[errors.size() / 2];
+    const double p90 = errors[errors.size() * 9 / 10];
+    std::cout << "  sketch relative error: median " << median << ", 90th percentile " << p90
+              << ", max " << errors.back() << " over " << errors.size() << " courses" << std::endl;
+    check(median <= 0.15, "median sketch error within 15%");
+    check(p90 <= 0.35, "90th percentile sketch error within 35%");
+    check(errors.back() <= 1.0, "every sketch estimate within 100%");
+
+    // The highest estimates are recomputed exactly, and they include the true top courses
+    check(analytics.refined.size() == kRefinedDownstream, "refined candidate count");
+    for (std::uint32_t v : analytics.refined) {
+        check(analytics.downstream[v] == static_cast<double>(exact[v]), "refined count is exact for " + courseNumber(v));
+    }
+    std::vector<size_t> byExact(n);
+    for (size_t i = 0; i < n; ++i) {
+        byExact[i] = i;
+    }
+    std::partial_sort(byExact.begin(), byExact.begin() + 10, byExact.end(),
+        [&](size_t a, size_t b) { return exact[a] != exact[b] ? exact[a] > exact[b] : a < b; });
+    for (size_t k = 0; k < 10; ++k) {
+        const bool found = std::find(analytics.refined.begin(), analytics.refined.end(), byExact[k]) != analytics.refined.end();
+        check(found, "true bottleneck " + courseNumber(byExact[k]) + " is among the refined candidates");
+    }
+}
+
+int main() {
+    std::cout << "Catalog analytics tests" << std::endl;
+    testSmallCatalog();
+    testSketchAccuracy();
+    std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " failures.") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
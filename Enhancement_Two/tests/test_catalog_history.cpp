@@ -0,0 +1,195 @@
+// Tests for CatalogHistory: path copying, pruning of removed courses, sharing of Course
+// objects between reloads and revisions, and diffs in both directions.
+//   g++ -std=c++17 -pthread test_catalog_history.cpp
+#define ABCU_NO_MAIN
+#include "../Enhanced_ABCU_Advising_Program.cpp"
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        ++failures;
+        std::cout << "FAIL: " << what << std::endl;
+    }
+}
+
+struct Catalog {
+    std::unordered_map<std::string, CoursePtr> courseMap;
+    std::vector<CoursePtr> sortedCourses;
+};
+
+// Function to build a catalog from course numbers, titles and prerequisites
+Catalog makeCatalog(const std::vector<Course>& courses) {
+    Catalog catalog;
+    for (const auto& course : courses) {
+        CoursePtr pointer = std::make_shared<const Course>(course);
+        catalog.courseMap.insert_or_assign(course.courseNumber, pointer);
+        catalog.sortedCourses.push_back(pointer);
+    }
+    return catalog;
+}
+
+// Function to list every course stored under a trie node, in key order, checking that
+// no empty node was left behind and that each bitmap matches its slots
+void collect(const HistoryNode* node, int level, std::vector<CoursePtr>& courses) {
+    if (node == nullptr) {
+        return;
+    }
+    const size_t slots = static_cast<size_t>(__builtin_popcount(node->bitmap));
+    check(node->bitmap != 0, "no empty nodes at level " + std::to_string(level));
+    if (level == 5) {
+        check(node->children.empty() && node->courses.size() == slots, "leaf slots match bitmap");
+        courses.insert(courses.end(), node->courses.begin(), node->courses.end());
+        return;
+    }
+    check(node->courses.empty() && node->children.size() == slots, "inner slots match bitmap");
+    for (const auto& child : node->children) {
+        collect(child.get(), level + 1, courses);
+    }
+}
+
+std::vector<std::string> courseNumbers(const CatalogHistory& history, size_t revision) {
+    std::vector<CoursePtr> courses;
+    collect(history.revision(revision).root.get(), 0, courses);
+    std::vector<std::string> numbers;
+    for (const auto& course : courses) {
+        numbers.push_back(course->courseNumber);
+    }
+    check(numbers.size() == history.revision(revision).courseCount, "course count of revision " + std::to_string(revision));
+    return numbers;
+}
+
+// Function to summarize a diff as "+CSCI100 -MATH201 ~CSCI200"
+std::string describeDiff(const std::vector<CourseChange>& changes) {
+    std::string text;
+    for (const auto& change : changes) {
+        text += text.empty() ? "" : " ";
+        switch (change.kind) {
+        case CourseChange::Kind::Added: text += "+" + change.after->courseNumber; break;
+        case CourseChange::Kind::Removed: text += "-" + change.before->courseNumber; break;
+        case CourseChange::Kind::Modified: text += "~" + change.after->courseNumber; break;
+        }
+    }
+    return text;
+}
+
+void testPathCopying() {
+    CatalogHistory history;
+    Catalog first = makeCatalog({ { "CSCI100", "Intro", {} }, { "CSCI200", "Data", { "CSCI100" } },
+                                  { "MATH201", "Discrete", {} }, { "ZOOL101", "Animals", {} } });
+    history.commit(first.courseMap, first.sortedCourses, "first");
+    const CoursePtr oldData = first.courseMap.at("CSCI200");
+
+    // Reloading with one change keeps the rest of the trie and every unchanged Course object
+    Catalog second = makeCatalog({ { "CSCI100", "Intro", {} }, { "CSCI200", "Data Structures", { "CSCI100" } },
+                                   { "MATH201", "Discrete", {} }, { "ZOOL101", "Animals", {} } });
+    history.commit(second.courseMap, second.sortedCourses, "second");
+
+    const HistoryNode* before = history.revision(1).root.get();
+    const HistoryNode* after = history.revision(2).root.get();
+    check(before != after, "changed revision gets a new root");
+    check(before->bitmap == after->bitmap, "root slots unchanged");
+    size_t shared = 0;
+    for (size_t i = 0; i < before->children.size(); ++i) {
+        shared += before->children[i] == after->children[i] ? 1 : 0;
+    }
+    check(shared == before->children.size() - 1, "only the path to CSCI200 is copied");
+
+    check(second.courseMap.at("CSCI100") == first.courseMap.at("CSCI100"), "unchanged course reused in courseMap");
+    check(second.sortedCourses[0] == first.courseMap.at("CSCI100"), "unchanged course reused in sortedCourses");
+    check(second.courseMap.at("CSCI200") != oldData, "changed course is a new object");
+
+    // The older revision still sees the old title
+    std::vector<CoursePtr> oldCourses;
+    collect(before, 0, oldCourses);
+    check(oldCourses.size() == 4 && oldCourses[1] == oldData && oldCourses[1]->courseTitle == "Data",
+          "first revision unchanged after second commit");
+
+    // Committing an identical catalog again shares the whole trie
+    Catalog third = makeCatalog({ { "CSCI100", "Intro", {} }, { "CSCI200", "Data Structures", { "CSCI100" } },
+                                  { "MATH201", "Discrete", {} }, { "ZOOL101", "Animals", {} } });
+    history.commit(third.courseMap, third.sortedCourses, "third");
+    check(history.revision(3).root == history.revision(2).root, "identical reload shares the root");
+    check(history.diff(2, 3).empty(), "identical reload has no changes");
+}
+
+void testErasePrunes() {
+    CatalogHistory history;
+    Catalog full = makeCatalog({ { "CSCI100", "Intro", {} }, { "CSCI101", "Intro II", {} }, { "MATH201", "Discrete", {} } });
+    history.commit(full.courseMap, full.sortedCourses, "full");
+    Catalog csOnly = makeCatalog({ { "CSCI100", "Intro", {} }, { "CSCI101", "Intro II", {} } });
+    history.commit(csOnly.courseMap, csOnly.sortedCourses, "cs only");
+    Catalog empty = makeCatalog({});
+    history.commit(empty.courseMap, empty.sortedCourses, "empty");
+
+    check(courseNumbers(history, 1) == std::vector<std::string>{ "CSCI100", "CSCI101", "MATH201" }, "full revision");
+    check(courseNumbers(history, 2) == std::vector<std::string>{ "CSCI100", "CSCI101" }, "MATH201 removed");
+    check(__builtin_popcount(history.revision(2).root->bitmap) == 1, "MATH subtree pruned from root");
+    check(history.revision(3).root == nullptr && history.revision(3).courseCount == 0, "empty revision has no root");
+    check(courseNumbers(history, 1).size() == 3, "removals leave older revisions intact");
+}
+
+void testDiff() {
+    CatalogHistory history;
+    Catalog empty = makeCatalog({});
+    history.commit(empty.courseMap, empty.sortedCourses, "empty");
+    Catalog first = makeCatalog({ { "MATH201", "Discrete", {} }, { "CSCI100", "Intro", {} }, { "CSCI200", "Data", {} } });
+    history.commit(first.courseMap, first.sortedCourses, "first");
+    Catalog second = makeCatalog({ { "CSCI100", "Intro", {} }, { "CSCI200", "Data", { "CSCI100" } }, { "CSCI300", "Algorithms", {} } });
+    history.commit(second.courseMap, second.sortedCourses, "second");
+
+    check(describeDiff(history.diff(1, 2)) == "+CSCI100 +CSCI200 +MATH201", "diff from empty revision");
+    check(describeDiff(history.diff(2, 1)) == "-CSCI100 -CSCI200 -MATH201", "diff to empty revision");
+    check(describeDiff(history.diff(2, 3)) == "~CSCI200 +CSCI300 -MATH201", "forward diff");
+    check(describeDiff(history.diff(3, 2)) == "~CSCI200 -CSCI300 +MATH201", "backward diff");
+    check(history.diff(3, 3).empty() && history.diff(1, 1).empty(), "diff with itself");
+
+    const auto changes = history.diff(2, 3);
+    check(changes[0].before->prerequisites.empty() && changes[0].after->prerequisites.size() == 1,
+          "modified change carries both versions");
+}
+
+void testReloadFromFile() {
+    const std::string path = (std::filesystem::temp_directory_path() / "abcu_history_test.csv").string();
+    auto write = [&](const std::string& text) {
+        std::ofstream(path, std::ios::binary) << text;
+    };
+
+    std::unordered_map<std::string, CoursePtr> courseMap;
+    std::vector<CoursePtr> sortedCourses;
+    LoadDiagnostics diagnostics;
+    CatalogHistory history;
+
+    write("CSCI100,Intro\nCSCI200,Data,CSCI100\nMATH201,Discrete\n");
+    loadCoursesFromFile(path, courseMap, sortedCourses, diagnostics);
+    history.commit(courseMap, sortedCourses, path);
+    const CoursePtr intro = courseMap.at("CSCI100");
+    const CoursePtr data = courseMap.at("CSCI200");
+
+    write("CSCI100,Intro\nCSCI200,Data Structures,CSCI100\nMATH201,Discrete\n");
+    loadCoursesFromFile(path, courseMap, sortedCourses, diagnostics);
+    check(courseMap.at("CSCI100") == intro, "loader reuses unchanged course");
+    history.commit(courseMap, sortedCourses, path);
+
+    std::vector<CoursePtr> stored;
+    collect(history.revision(2).root.get(), 0, stored);
+    std::vector<CoursePtr> storedBefore;
+    collect(history.revision(1).root.get(), 0, storedBefore);
+    check(storedBefore[0] == intro && storedBefore[1] == data, "first revision keeps its objects");
+    storedBefore.clear();
+    check(stored.size() == 3 && stored[0] == intro && stored[0] == sortedCourses[0], "one CSCI100 object shared by all");
+    check(stored[1] == courseMap.at("CSCI200") && stored[1] != data, "changed course stored once");
+    // Held by the trie leaf both revisions share, courseMap, sortedCourses, intro and stored
+    check(intro.use_count() == 5, "no extra copies of an unchanged course");
+    std::filesystem::remove(path);
+}
+
+int main() {
+    std::cout << "CatalogHistory tests" << std::endl;
+    testPathCopying();
+    testErasePrunes();
+    testDiff();
+    testReloadFromFile();
+    std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " failures.") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
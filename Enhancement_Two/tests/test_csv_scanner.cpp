@@ -0,0 +1,172 @@
+// Tests for scanCsv. Build once per classification path and run each binary:
+//   g++ -std=c++17 -pthread test_csv_scanner.cpp                        (SSE2)
+//   g++ -std=c++17 -pthread -mavx2 test_csv_scanner.cpp                 (AVX2)
+//   g++ -std=c++17 -pthread -U__SSE2__ -U__AVX2__ test_csv_scanner.cpp  (scalar)
+// run_tests.sh does all three. Every build must match the same expected fields, and the
+// random inputs are checked against a byte-at-a-time reference parser.
+#define ABCU_NO_MAIN
+#include "../Enhanced_ABCU_Advising_Program.cpp"
+
+#include <random>
+
+// A record as seen by the onRecord callback
+struct ScannedRecord {
+    std::vector<std::string> fields;
+    size_t lineNumber;
+    size_t byteOffset;
+
+    bool operator==(const ScannedRecord& other) const {
+        return fields == other.fields && lineNumber == other.lineNumber && byteOffset == other.byteOffset;
+    }
+};
+
+struct ScannedFile {
+    std::vector<ScannedRecord> records;
+    size_t lines;
+    bool unterminatedQuote;
+
+    bool operator==(const ScannedFile& other) const {
+        return records == other.records && lines == other.lines && unterminatedQuote == other.unterminatedQuote;
+    }
+};
+
+// Function to run scanCsv and keep the raw fields of every record
+ScannedFile scan(std::string_view data) {
+    ScannedFile file;
+    const CsvScanResult result = scanCsv(data,
+        [&](const CsvFields& fields, std::string_view, size_t lineNumber, size_t byteOffset) {
+            file.records.push_back({ std::vector<std::string>(fields.begin(), fields.end()), lineNumber, byteOffset });
+        });
+    file.lines = result.lines;
+    file.unterminatedQuote = result.unterminatedQuote;
+    return file;
+}
+
+// Reference parser: one byte at a time, written independently of the block scanner
+ScannedFile referenceScan(const std::string& data) {
+    ScannedFile file{ {}, 0, false };
+    std::vector<std::string> fields;
+    size_t fieldStart = 0, recordStart = 0, line = 1, quotedNewlines = 0;
+    bool inQuotes = false, afterSeparator = true, afterClosingQuote = false;
+    auto endRecord = [&](size_t end) {
+        fields.push_back(data.substr(fieldStart, end - fieldStart));
+        if (!fields.back().empty() && fields.back().back() == '\r') {
+            fields.back().pop_back();
+        }
+        file.records.push_back({ fields, line, recordStart });
+        fields.clear();
+        line += quotedNewlines + 1;
+        quotedNewlines = 0;
+        fieldStart = recordStart = end + 1;
+    };
+    for (size_t i = 0; i < data.size(); ++i) {
+        const char c = data[i];
+        const bool wasInQuotes = inQuotes;
+        bool closing = false;
+        if (inQuotes) {
+            closing = c == '"';
+            inQuotes = !closing;
+            quotedNewlines += c == '\n';
+        } else if (c == '"' && (afterSeparator || afterClosingQuote)) {
+            inQuotes = true;
+        } else if (c == ',') {
+            fields.push_back(data.substr(fieldStart, i - fieldStart));
+            fieldStart = i + 1;
+        } else if (c == '\n') {
+            endRecord(i);
+        }
+        afterSeparator = !wasInQuotes && (c == ',' || c == '\n');
+        afterClosingQuote = closing;
+    }
+    if (inQuotes) {
+        file.unterminatedQuote = true;
+        line += static_cast<size_t>(std::count(data.begin() + recordStart, data.end(), '\n'));
+        line += data.back() != '\n';
+    } else if (recordStart < data.size()) {
+        endRecord(data.size());
+    }
+    file.lines = line - 1;
+    return file;
+}
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        ++failures;
+        std::cout << "FAIL: " << what << std::endl;
+    }
+}
+
+// Function to check the values (quotes removed) and line numbers of every record
+void expectRecords(const std::string& name, const std::string& data,
+                   const std::vector<std::vector<std::string>>& values, const std::vector<size_t>& lineNumbers,
+                   size_t lines, bool unterminated = false) {
+    const ScannedFile file = scan(data);
+    check(file.records.size() == values.size(), name + ": record count");
+    for (size_t r = 0; r < std::min(file.records.size(), values.size()); ++r) {
+        std::vector<std::string> decoded;
+        for (const auto& raw : file.records[r].fields) {
+            decoded.push_back(csvFieldValue(raw));
+        }
+        check(decoded == values[r], name + ": fields of record " + std::to_string(r + 1));
+        check(file.records[r].lineNumber == lineNumbers[r], name + ": line of record " + std::to_string(r + 1));
+    }
+    check(file.lines == lines, name + ": line count");
+    check(file.unterminatedQuote == unterminated, name + ": unterminated flag");
+    check(file == referenceScan(data), name + ": matches reference parser");
+}
+
+int main() {
+#if defined(__AVX2__)
+    std::cout << "scanCsv tests (AVX2)" << std::endl;
+#elif defined(__SSE2__)
+    std::cout << "scanCsv tests (SSE2)" << std::endl;
+#else
+    std::cout << "scanCsv tests (scalar)" << std::endl;
+#endif
+
+    expectRecords("plain", "CSCI100,Intro\nCSCI200,Data,CSCI100\n",
+        { { "CSCI100", "Intro" }, { "CSCI200", "Data", "CSCI100" } }, { 1, 2 }, 2);
+    expectRecords("empty fields", "CSCI100,,\n,\n",
+        { { "CSCI100", "", "" }, { "", "" } }, { 1, 2 }, 2);
+    expectRecords("embedded comma", "CSCI100,\"Intro, to CS\",CSCI050\n",
+        { { "CSCI100", "Intro, to CS", "CSCI050" } }, { 1 }, 1);
+    expectRecords("doubled quotes", "CSCI200,\"The \"\"Data\"\" Course\"\n",
+        { { "CSCI200", "The \"Data\" Course" } }, { 1 }, 1);
+    expectRecords("crlf", "CSCI100,Intro\r\nCSCI200,\"Data\"\r\n",
+        { { "CSCI100", "Intro" }, { "CSCI200", "Data" } }, { 1, 2 }, 2);
+    expectRecords("quoted newline", "CSCI300,\"Multi\nline\",CSCI200\nCSCI400,Next\n",
+        { { "CSCI300", "Multi\nline", "CSCI200" }, { "CSCI400", "Next" } }, { 1, 3 }, 3);
+    expectRecords("no trailing newline", "CSCI100,Intro\nCSCI200,Data",
+        { { "CSCI100", "Intro" }, { "CSCI200", "Data" } }, { 1, 2 }, 2);
+    expectRecords("stray quotes", "CSCI301,12\" Ruler Design,CSCI100\nCSCI302,Normal\nCSCI303,Another 3\" thing\nbad,line\n",
+        { { "CSCI301", "12\" Ruler Design", "CSCI100" }, { "CSCI302", "Normal" },
+          { "CSCI303", "Another 3\" thing" }, { "bad", "line" } }, { 1, 2, 3, 4 }, 4);
+    expectRecords("unterminated quote", "a,b\nc,\"d\ne\n",
+        { { "a", "b" } }, { 1 }, 3, true);
+    expectRecords("unterminated quote without newline", "a,b\nc,\"d\ne",
+        { { "a", "b" } }, { 1 }, 3, true);
+
+    // Quoted fields and stray quotes that straddle 64-byte block boundaries
+    const std::string padding(60, 'x');
+    expectRecords("block boundary", padding + ",\"a,b\nc\"\"d\"," + padding + "9\" e,f\n",
+        { { padding, "a,b\nc\"d", padding + "9\" e", "f" } }, { 1 }, 2);
+
+    // Random inputs built from the characters that matter, compared with the reference parser
+    std::mt19937 random(2024);
+    const std::string alphabet = "ab,,\"\"\n\r ";
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        std::string data(random() % 300, ' ');
+        for (char& c : data) {
+            c = alphabet[random() % alphabet.size()];
+        }
+        if (!(scan(data) == referenceScan(data))) {
+            check(false, "random input " + std::to_string(iteration) + " differs from reference parser");
+            break;
+        }
+    }
+
+    std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " failures.") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,272 @@
+// Tests for LoadDiagnostics: warnings recorded by loadCoursesFromFile for each kind of bad row,
+// their line numbers and byte offsets, the console rate limit, the summary and the JSON report.
+//   g++ -std=c++17 -pthread test_load_diagnostics.cpp
+#define ABCU_NO_MAIN
+#include "../Enhanced_ABCU_Advising_Program.cpp"
+
+#include <map>
+#include <sstream>
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        ++failures;
+        std::cout << "FAIL: " << what << std::endl;
+    }
+}
+
+// Minimal JSON value and parser, enough to check that the report is well-formed
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object } type = Type::Null;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::map<std::string, JsonValue> members;
+
+    const JsonValue& operator[](const std::string& key) const {
+        static const JsonValue missing;
+        auto it = members.find(key);
+        return it == members.end() ? missing : it->second;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& input) : text(input) {}
+
+    // Parse the whole input; returns false on any syntax error or trailing characters
+    bool parse(JsonValue& value) {
+        if (!parseValue(value)) {
+            return false;
+        }
+        skipSpace();
+        return position == text.size();
+    }
+
+private:
+    void skipSpace() {
+        while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+            ++position;
+        }
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (position < text.size() && text[position] == c) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        while (position < text.size() && text[position] != '"') {
+            if (text[position] == '\\' || static_cast<unsigned char>(text[position]) < 0x20) {
+                return false;   // the report never needs escapes
+            }
+            out.push_back(text[position++]);
+        }
+        return position++ < text.size();
+    }
+
+    bool parseValue(JsonValue& value) {
+        skipSpace();
+        if (position >= text.size()) {
+            return false;
+        }
+        const char c = text[position];
+        if (c == '{') {
+            value.type = JsonValue::Type::Object;
+            ++position;
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                std::string key;
+                JsonValue member;
+                if (!parseString(key) || !consume(':') || !parseValue(member) || value.members.count(key)) {
+                    return false;
+                }
+                value.members.emplace(key, member);
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            value.type = JsonValue::Type::Array;
+            ++position;
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back())) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::String;
+            return parseString(value.text);
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            size_t end = position + 1;
+            while (end < text.size() && std::strchr("0123456789.eE+-", text[end]) != nullptr) {
+                ++end;
+            }
+            value.type = JsonValue::Type::Number;
+            value.number = std::stod(text.substr(position, end - position));
+            position = end;
+            return true;
+        }
+        for (const char* literal : { "true", "false", "null" }) {
+            if (text.compare(position, std::strlen(literal), literal) == 0) {
+                value.type = literal[0] == 'n' ? JsonValue::Type::Null : JsonValue::Type::Bool;
+                value.number = literal[0] == 't' ? 1.0 : 0.0;
+                position += std::strlen(literal);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::string& text;
+    size_t position = 0;
+};
+
+std::string temporaryPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// One bad row of every kind; CSCI200's quoted title spans two lines, so later rows must not
+// be numbered as if every record were one line
+const std::string kFixture =
+    "CSCI100,Intro\n"                                 // line 1
+    "CSCI200,\"Data,\nStructures\",CSCI100\n"         // lines 2-3
+    "bad,Not a course number\n"                       // line 4: invalid course number
+    "CSCI300\n"                                       // line 5: invalid line (no title)
+    "CSCI400,Capstone,CSCI1,XX,CSCI100,YY,ZZ\n"       // line 6: four invalid prerequisites
+    "\n"                                              // line 7: blank, ignored
+    "CSCI500,\"Unterminated\n"                        // line 8: unterminated quote
+    "rest of the file\n";                             // line 9
+
+void testLoadWarnings() {
+    const std::string csvPath = temporaryPath("abcu_diagnostics_test.csv");
+    const std::string reportPath = temporaryPath("abcu_diagnostics_test.json");
+    std::ofstream(csvPath, std::ios::binary) << kFixture;
+
+    std::unordered_map<std::string, CoursePtr> courseMap;
+    std::vector<CoursePtr> sortedCourses;
+    LoadDiagnostics diagnostics(2);
+
+    // Capture the console to check the rate limit and the summary
+    std::ostringstream console;
+    std::streambuf* original = std::cout.rdbuf(console.rdbuf());
+    const bool loaded = loadCoursesFromFile(csvPath, courseMap, sortedCourses, diagnostics);
+    std::cout.rdbuf(original);
+    const std::string output = console.str();
+
+    check(loaded, "fixture loads");
+    check(sortedCourses.size() == 3, "CSCI100, CSCI200 and CSCI400 loaded");
+    check(courseMap.count("CSCI400") && courseMap.at("CSCI400")->prerequisites == std::vector<std::string>{ "CSCI100" },
+          "valid prerequisite kept next to invalid ones");
+    check(diagnostics.warningCount() == 7, "one warning per bad row or prerequisite");
+
+    size_t printed = 0;
+    for (size_t at = output.find("Warning: invalid prerequisite at line 6"); at != std::string::npos;
+         at = output.find("Warning: invalid prerequisite at line 6", at + 1)) {
+        ++printed;
+    }
+    check(printed == 2, "only the first two invalid prerequisites are printed");
+    check(output.find("Warning: further 'invalid prerequisite' warnings suppressed") != std::string::npos,
+          "suppression notice printed");
+    check(output.find("Warning: invalid course number at line 4: 'bad'") != std::string::npos, "course number warning text");
+    check(output.find("Load summary: 3 courses loaded from 9 lines, 7 warnings (1 invalid line, 1 invalid course number, "
+                      "4 invalid prerequisite, 1 unterminated quote)") != std::string::npos, "summary line");
+
+    check(diagnostics.writeReport(reportPath), "report written");
+    const std::string reportText = readFile(reportPath);
+    JsonValue report;
+    check(JsonParser(reportText).parse(report), "report parses as JSON");
+    check(report.type == JsonValue::Type::Object && report.members.size() == 4, "report has four members");
+    check(report["lines_read"].number == 9 && report["courses_loaded"].number == 3, "report totals");
+
+    const JsonValue& counts = report["counts"];
+    check(counts.members.size() == 4, "one count per warning code");
+    check(counts["invalid_line"].number == 1 && counts["invalid_course_number"].number == 1 &&
+          counts["invalid_prerequisite"].number == 4 && counts["unterminated_quote"].number == 1, "per-code counts");
+
+    // Every warning, printed or suppressed, with the line and byte offset where its record starts
+    struct Expected { size_t line; size_t offset; std::string code; };
+    const size_t line4 = kFixture.find("bad,");
+    const size_t line5 = kFixture.find("CSCI300");
+    const size_t line6 = kFixture.find("CSCI400");
+    const size_t line8 = kFixture.find("CSCI500");
+    const std::vector<Expected> expected{
+        { 4, line4, "invalid_course_number" }, { 5, line5, "invalid_line" },
+        { 6, line6, "invalid_prerequisite" }, { 6, line6, "invalid_prerequisite" },
+        { 6, line6, "invalid_prerequisite" }, { 6, line6, "invalid_prerequisite" },
+        { 8, line8, "unterminated_quote" },
+    };
+    const JsonValue& warnings = report["warnings"];
+    check(warnings.type == JsonValue::Type::Array && warnings.items.size() == expected.size(), "warning list length");
+    for (size_t i = 0; i < std::min(expected.size(), warnings.items.size()); ++i) {
+        const JsonValue& w = warnings.items[i];
+        check(w.members.size() == 3 && w["line"].number == expected[i].line && w["offset"].number == expected[i].offset &&
+              w["code"].text == expected[i].code, "warning " + std::to_string(i + 1) + " is " + expected[i].code +
+              " at line " + std::to_string(expected[i].line));
+    }
+
+    // A clean reload resets the counts and the report
+    std::ofstream(csvPath, std::ios::binary) << "CSCI100,Intro\n";
+    std::cout.rdbuf(console.rdbuf());
+    loadCoursesFromFile(csvPath, courseMap, sortedCourses, diagnostics);
+    std::cout.rdbuf(original);
+    diagnostics.writeReport(reportPath);
+    JsonValue clean;
+    check(JsonParser(readFile(reportPath)).parse(clean), "clean report parses as JSON");
+    check(clean["warnings"].type == JsonValue::Type::Array && clean["warnings"].items.empty() &&
+          clean["counts"]["invalid_prerequisite"].number == 0, "clean reload has no warnings");
+
+    std::filesystem::remove(csvPath);
+    std::filesystem::remove(reportPath);
+}
+
+void testRateLimitPerCategory() {
+    LoadDiagnostics diagnostics(3);
+    std::ostringstream console;
+    std::streambuf* original = std::cout.rdbuf(console.rdbuf());
+    for (size_t i = 0; i < 10; ++i) {
+        diagnostics.record(LoadIssue::InvalidLine, i + 1, i * 10, "x");
+    }
+    diagnostics.record(LoadIssue::InvalidCourseNumber, 11, 100, "y");
+    std::cout.rdbuf(original);
+
+    const std::string output = console.str();
+    size_t lines = 0;
+    for (char c : output) {
+        lines += c == '\n' ? 1 : 0;
+    }
+    check(lines == 5, "three warnings, one suppression notice, and the other category still printed");
+    check(output.find("at line 11: 'y'") != std::string::npos, "limit is per category");
+    check(diagnostics.warningCount() == 11, "suppressed warnings are still recorded");
+}
+
+int main() {
+    std::cout << "LoadDiagnostics tests" << std::endl;
+    testLoadWarnings();
+    testRateLimitPerCategory();
+    std::cout << (failures == 0 ? "All tests passed." : std::to_string(failures) + " failures.") << std::endl;
+    return failures == 0 ? 0 : 1;
+}